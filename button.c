@@ -0,0 +1,108 @@
+/*
+ * Debounced push button on RA5 (active low)
+ */
+
+#include "mcc_generated_files/mcc.h"
+#include "button.h"
+
+static volatile uint8_t queue[BUTTON_QUEUE_SIZE];
+static volatile uint8_t queueHead = 0;
+static volatile uint8_t queueTail = 0;
+
+// sampler state, only touched from interrupt context
+static volatile bool active = false;
+static uint8_t integrator = 0;
+static bool pressed = false;
+static bool reported = false;   // the gesture of this press is sent
+static uint16_t holdTicks = 0;
+static uint8_t doubleWindow = 0;   // ticks left for the second press of a double
+
+static void pushEvent(ButtonEvent_t event)
+{
+    uint8_t next = (queueHead + 1) & (BUTTON_QUEUE_SIZE - 1);
+
+    // drop the event if the main loop did not keep up
+    if(next != queueTail) {
+        queue[queueHead] = event;
+        queueHead = next;
+    }
+}
+
+void BUTTON_Initialize(void)
+{
+    queueHead = 0;
+    queueTail = 0;
+    integrator = 0;
+    pressed = false;
+    doubleWindow = 0;
+
+    // sample at least once in case the button is held at power up
+    active = true;
+}
+
+void BUTTON_ChangeISR(void)
+{
+    active = true;
+}
+
+void BUTTON_SampleISR(void)
+{
+    if(!active) {
+        return;
+    }
+
+    // integrate the raw level, button is active low
+    if(!Button_GetValue()) {
+        if(integrator < BUTTON_INTEGRATOR_MAX) {
+            ++integrator;
+        }
+    } else if(integrator) {
+        --integrator;
+    }
+
+    if(!pressed) {
+        if(integrator == BUTTON_INTEGRATOR_MAX) {
+            pressed = true;
+            holdTicks = 0;
+
+            // the second press of a double ends the gesture, its hold and
+            // release count for nothing
+            reported = (doubleWindow != 0);
+            if(reported) {
+                doubleWindow = 0;
+                pushEvent(BUTTON_EVENT_DOUBLE_PRESS);
+            }
+        } else if(doubleWindow) {
+            // no second press in time, it was a short one
+            if(--doubleWindow == 0) {
+                pushEvent(BUTTON_EVENT_SHORT_PRESS);
+            }
+        } else if(integrator == 0) {
+            // settled and nothing to time, wait for the next edge
+            active = false;
+        }
+    } else {
+        if(integrator == 0) {
+            pressed = false;
+            if(!reported) {
+                doubleWindow = BUTTON_DOUBLE_PRESS_TICKS;
+            }
+        } else if(!reported && ++holdTicks >= BUTTON_LONG_PRESS_TICKS) {
+            reported = true;
+            pushEvent(BUTTON_EVENT_LONG_PRESS);
+        }
+    }
+}
+
+ButtonEvent_t BUTTON_GetEvent(void)
+{
+    ButtonEvent_t event;
+
+    if(queueTail == queueHead) {
+        return BUTTON_EVENT_NONE;
+    }
+
+    event = (ButtonEvent_t)queue[queueTail];
+    queueTail = (queueTail + 1) & (BUTTON_QUEUE_SIZE - 1);
+    return event;
+}
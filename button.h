@@ -0,0 +1,61 @@
+/*
+ * Debounced push button on RA5 (active low)
+ *
+ * Interrupt-on-change arms the debouncer, the TMR2 tick samples the pin into
+ * an integrator and pushes the decoded gestures into a small event queue.
+ * Nothing here blocks, the output keeps running while the button is held.
+ *
+ * Every gesture is reported once, when it can no longer turn into another
+ * one: a long press while still held, a double press on its second press,
+ * a short press once the double press window after its release is over.
+ */
+
+#ifndef BUTTON_H
+#define BUTTON_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "scheduler.h"
+
+// consecutive equal samples needed to accept a new level
+#define BUTTON_INTEGRATOR_MAX       4
+
+// held at least this long -> long press (sent once, while still held)
+#define BUTTON_LONG_PRESS_TICKS     SCHEDULER_MS_TO_TICKS(1000)
+
+// second press within this time after a short release -> double press,
+// also the delay of a short press
+#define BUTTON_DOUBLE_PRESS_TICKS   SCHEDULER_MS_TO_TICKS(400)
+
+// event queue length, must be a power of two
+#define BUTTON_QUEUE_SIZE           4
+
+typedef enum ButtonEvent {
+    BUTTON_EVENT_NONE         = 0,
+    BUTTON_EVENT_SHORT_PRESS  = 1,
+    BUTTON_EVENT_LONG_PRESS   = 2,
+    BUTTON_EVENT_DOUBLE_PRESS = 3
+} ButtonEvent_t;
+
+/**
+ * Reset the debouncer and the event queue, also drops a gesture in progress
+ */
+void BUTTON_Initialize(void);
+
+/**
+ * Interrupt-on-change handler for the button pin, wakes the sampler up
+ */
+void BUTTON_ChangeISR(void);
+
+/**
+ * Sample and debounce the button. Called on every tick (interrupt context).
+ */
+void BUTTON_SampleISR(void);
+
+/**
+ * Pop the oldest pending event
+ * @return BUTTON_EVENT_NONE if the queue is empty
+ */
+ButtonEvent_t BUTTON_GetEvent(void);
+
+#endif // BUTTON_H
@@ -0,0 +1,38 @@
+/*
+ * Clock governor
+ */
+
+#include "profile.h"
+#include "fade.h"
+#include "ramp.h"
+#include "weather.h"
+#include "clock.h"
+
+static uint16_t holdTicks;
+
+void CLOCK_Initialize(void)
+{
+    holdTicks = CLOCK_HOLD_TICKS;
+}
+
+void CLOCK_Task(void)
+{
+    if(FADE_IsActive() || RAMP_IsActive() || WEATHER_IsActive()) {
+        holdTicks = CLOCK_HOLD_TICKS;
+        PROFILE_SetSlow(false);
+        return;
+    }
+
+    if(holdTicks) {
+        holdTicks--;
+    } else if(!PROFILE_IsSlow()) {
+        // stays fast if the profile has no slow variant, try again later
+        PROFILE_SetSlow(true);
+        holdTicks = CLOCK_HOLD_TICKS;
+    }
+}
+
+bool CLOCK_IsSlow(void)
+{
+    return PROFILE_IsSlow();
+}
@@ -0,0 +1,43 @@
+/*
+ * Clock governor
+ *
+ * Runs the core from HFINTOSC / 2 (16 MHz) while the output is static and
+ * at the full 32 MHz while a fade, a ramp or the weather changes it. PR2
+ * is halved with the clock (see profile.c), so the PWM frequency, the tick
+ * and the RTC stay the same; the output stage rescales and dithers the
+ * duties of the shorter period.
+ *
+ * A divider of 4 would leave 48 instruction cycles per PWM period in the
+ * standard profile, less than the period ISR needs to load four channels
+ * before the next match. For the same reason the high frequency profile
+ * always runs at 32 MHz.
+ *
+ * __delay_ms() assumes 32 MHz and must not be used while slow.
+ */
+
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "scheduler.h"
+
+// static this long before slowing down
+#define CLOCK_HOLD_TICKS        SCHEDULER_MS_TO_TICKS(1000)
+
+/**
+ * Start at full speed
+ */
+void CLOCK_Initialize(void);
+
+/**
+ * Pick the clock from the output activity, scheduler task with a period of 1 tick
+ */
+void CLOCK_Task(void);
+
+/**
+ * @return running from the divided clock
+ */
+bool CLOCK_IsSlow(void);
+
+#endif // CLOCK_H
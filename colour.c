@@ -0,0 +1,58 @@
+/*
+ * HSV colour engine
+ */
+
+#include "gamma.h"
+#include "colour.h"
+
+void COLOUR_HsvToLevels(uint16_t hue, uint8_t saturation, uint8_t value, uint16_t *levels)
+{
+    uint16_t full = GAMMA_LEVEL(value);
+    uint32_t scaled;
+    uint16_t chroma, rising, falling;
+    uint8_t sector;
+
+    // full * saturation / 255 rounded, 1/255 = 1/256 + 1/256^2 + 1/256^3 ...
+    scaled = (uint32_t)full * saturation + 128;
+    chroma = (uint16_t)((scaled + (scaled >> 8) + (scaled >> 16)) >> 8);
+
+    // hue * 6: the sector in the top bits, the fraction across it in the low 16
+    scaled = ((uint32_t)hue << 2) + ((uint32_t)hue << 1);
+    sector = (uint8_t)(scaled >> 16);
+    rising = (uint16_t)(((uint32_t)chroma * (uint16_t)scaled + 0x8000) >> 16);
+    falling = chroma - rising;
+
+    // the common part is white, one colour is full chroma, one moves, one is off
+    levels[OUTPUT_WHITE] = full - chroma;
+    switch(sector) {
+        case 0:     // red to yellow
+            levels[OUTPUT_RED] = chroma;
+            levels[OUTPUT_GREEN] = rising;
+            levels[OUTPUT_BLUE] = 0;
+            break;
+        case 1:     // yellow to green
+            levels[OUTPUT_RED] = falling;
+            levels[OUTPUT_GREEN] = chroma;
+            levels[OUTPUT_BLUE] = 0;
+            break;
+        case 2:     // green to cyan
+            levels[OUTPUT_RED] = 0;
+            levels[OUTPUT_GREEN] = chroma;
+            levels[OUTPUT_BLUE] = rising;
+            break;
+        case 3:     // cyan to blue
+            levels[OUTPUT_RED] = 0;
+            levels[OUTPUT_GREEN] = falling;
+            levels[OUTPUT_BLUE] = chroma;
+            break;
+        case 4:     // blue to magenta
+            levels[OUTPUT_RED] = rising;
+            levels[OUTPUT_GREEN] = 0;
+            levels[OUTPUT_BLUE] = chroma;
+            break;
+        default:    // magenta to red
+            levels[OUTPUT_RED] = chroma;
+            levels[OUTPUT_GREEN] = 0;
+            levels[OUTPUT_BLUE] = falling;
+    }
+}
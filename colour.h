@@ -0,0 +1,44 @@
+/*
+ * HSV colour engine
+ *
+ * Turns a hue, a saturation and a logical brightness into the four output
+ * levels. The value is mapped through the gamma table first and the colour
+ * is mixed from there in linear light, where the LEDs add up: the part all
+ * three colours have in common goes to the white channel, which makes the
+ * same light from one LED instead of three, and red, green and blue only
+ * carry the chroma. A grey is white alone, a saturated colour leaves
+ * white off.
+ *
+ * Fixed point throughout, no division: the hue splits into its sector and
+ * the fraction across it with shifts, the saturation divides by 255 with
+ * a rounding reciprocal series. Two multiplies per colour, cheap enough
+ * for an effect that renders every tick. Every level is within one of the
+ * exact result, far below a dithered duty step.
+ *
+ * The white LED is taken to match equal red, green and blue levels.
+ */
+
+#ifndef COLOUR_H
+#define COLOUR_H
+
+#include <stdint.h>
+#include "output.h"
+
+// hues, a full turn of the colour wheel is 0x10000 so sweeps wrap by themselves
+#define COLOUR_HUE_RED          0x0000
+#define COLOUR_HUE_YELLOW       0x2AAB
+#define COLOUR_HUE_GREEN        0x5555
+#define COLOUR_HUE_CYAN         0x8000
+#define COLOUR_HUE_BLUE         0xAAAB
+#define COLOUR_HUE_MAGENTA      0xD555
+
+/**
+ * Output levels of a colour
+ * @param hue position on the colour wheel, see COLOUR_HUE_
+ * @param saturation 0 grey (white only) .. 255 pure colour (no white)
+ * @param value logical brightness of the brightest channel (0..255, see gamma.h)
+ * @param levels OUTPUT_CHANNEL_COUNT output levels, indexed by OutputChannel_t
+ */
+void COLOUR_HsvToLevels(uint16_t hue, uint8_t saturation, uint8_t value, uint16_t *levels);
+
+#endif // COLOUR_H
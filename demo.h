@@ -0,0 +1,37 @@
+/*
+ * Demo effects of main.c
+ *
+ * loop_for_demo() runs one effect per state in place of the panel presets.
+ * The main loop runs the panel, so only host/test_demo.c calls it, with the
+ * settings below.
+ */
+
+#ifndef DEMO_H
+#define DEMO_H
+
+#include "scheduler.h"
+
+// states of loop_for_demo(), 0 switches off, 3 - 6 light one channel each
+#define DEMO_STATE_RANDOM       1
+#define DEMO_STATE_BLINKING     2
+#define DEMO_STATE_RAINBOW      7
+
+// effect step periods
+#define BLINKING_STEP_TICKS     SCHEDULER_MS_TO_TICKS(10)
+#define RANDOM_STEP_TICKS       SCHEDULER_MS_TO_TICKS(1000)
+
+// random colour: logical brightness 0..RANDOM_BRIGHTNESS_COUNT - 1, crossfade time
+#define RANDOM_BRIGHTNESS_COUNT 40
+#define RANDOM_FADE_TICKS       SCHEDULER_MS_TO_TICKS(500)
+
+// colour wheel: hue advance per tick (a turn in ~66 s), saturation and logical brightness
+#define RAINBOW_HUE_STEP        3
+#define RAINBOW_SATURATION      255
+#define RAINBOW_BRIGHTNESS      160
+
+/**
+ * Step the effect of the current state, call on every tick
+ */
+void loop_for_demo(void);
+
+#endif // DEMO_H
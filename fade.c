@@ -0,0 +1,111 @@
+/*
+ * Crossfade engine
+ */
+
+#include "output.h"
+#include "fade.h"
+
+// the output level is the integer part of the accumulator, a fall is a
+// negative increment in two's complement
+typedef struct FadeChannel {
+    uint32_t increment; // Q16.16 per step
+    uint16_t fraction;  // below the output level
+    uint16_t target;
+} FadeChannel_t;
+
+static FadeChannel_t channels[OUTPUT_CHANNEL_COUNT];
+static uint32_t remaining;
+static FadeMode_t running;
+
+void FADE_Initialize(void)
+{
+    remaining = 0;
+}
+
+static void start(OutputChannel_t channel, uint16_t target, uint32_t steps)
+{
+    FadeChannel_t *fc = &channels[channel];
+    uint16_t level = OUTPUT_GetChannel(channel);
+
+    fc->target = target;
+    fc->fraction = 0;
+
+    // truncated, falls short by less than steps / 0x10000 levels before the last step
+    if(target >= level) {
+        fc->increment = ((uint32_t)(target - level) << 16) / steps;
+    } else {
+        fc->increment = -(((uint32_t)(level - target) << 16) / steps);
+    }
+}
+
+void FADE_Start(FadeMode_t mode, uint16_t red, uint16_t green, uint16_t blue, uint16_t white, uint32_t steps)
+{
+    if(steps == 0) {
+        remaining = 0;
+        OUTPUT_SetRGBW(red, green, blue, white);
+        return;
+    }
+
+    start(OUTPUT_RED, red, steps);
+    start(OUTPUT_GREEN, green, steps);
+    start(OUTPUT_BLUE, blue, steps);
+    start(OUTPUT_WHITE, white, steps);
+    running = mode;
+    remaining = steps;
+}
+
+void FADE_StopMode(FadeMode_t mode)
+{
+    if(running == mode) {
+        remaining = 0;
+    }
+}
+
+bool FADE_IsRunning(FadeMode_t mode)
+{
+    return remaining != 0 && running == mode;
+}
+
+void FADE_Step(FadeMode_t mode)
+{
+    if(remaining == 0 || running != mode) {
+        return;
+    }
+
+    if(--remaining == 0) {
+        // make up for the truncated increments on the last step
+        for(uint8_t i = 0; i < OUTPUT_CHANNEL_COUNT; i++) {
+            OUTPUT_SetChannel((OutputChannel_t)i, channels[i].target);
+        }
+        return;
+    }
+
+    for(uint8_t i = 0; i < OUTPUT_CHANNEL_COUNT; i++) {
+        FadeChannel_t *fc = &channels[i];
+        // a fall wraps the 32 bit sum, which stays exact
+        uint32_t level = (((uint32_t)OUTPUT_GetChannel((OutputChannel_t)i) << 16) | fc->fraction) + fc->increment;
+
+        fc->fraction = (uint16_t)level;
+        OUTPUT_SetChannel((OutputChannel_t)i, (uint16_t)(level >> 16));
+    }
+}
+
+void FADE_To(uint16_t red, uint16_t green, uint16_t blue, uint16_t white, uint16_t ticks)
+{
+    FADE_Start(FADE_MODE_FADE, red, green, blue, white, ticks);
+}
+
+void FADE_Stop(void)
+{
+    FADE_StopMode(FADE_MODE_FADE);
+}
+
+bool FADE_IsActive(void)
+{
+    return FADE_IsRunning(FADE_MODE_FADE);
+}
+
+void FADE_Task(void)
+{
+    FADE_Step(FADE_MODE_FADE);
+}
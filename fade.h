@@ -0,0 +1,86 @@
+/*
+ * Crossfade engine
+ *
+ * Walks all four output channels from their current level to a target
+ * over a number of steps. Every channel keeps a Q16.16 accumulator and
+ * adds a constant increment per step, worked out once when the trajectory
+ * starts; every step then costs one 32 bit addition per channel. The
+ * increments are truncated and the last step lands on the target, so the
+ * trajectory is monotonic and ends exactly where it should.
+ *
+ * One trajectory runs at a time, with one set of accumulators: a fade
+ * steps on every scheduler tick, a ramp (see ramp.h) every
+ * RAMP_STEP_TICKS, and starting either one replaces the other.
+ *
+ * Levels are the OUTPUT_ values, Q8.8 of the 8 bit duty.
+ */
+
+#ifndef FADE_H
+#define FADE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "scheduler.h"
+
+// default crossfade between two panel levels
+#ifndef FADE_DEFAULT_MS
+#define FADE_DEFAULT_MS         600
+#endif
+#define FADE_DEFAULT_TICKS      SCHEDULER_MS_TO_TICKS(FADE_DEFAULT_MS)
+
+// task that steps a trajectory
+typedef enum FadeMode {
+    FADE_MODE_FADE,     // FADE_Task(), every tick
+    FADE_MODE_RAMP      // RAMP_Task(), every RAMP_STEP_TICKS
+} FadeMode_t;
+
+/**
+ * Stop any fade or ramp
+ */
+void FADE_Initialize(void);
+
+/**
+ * Start a fade from the current output levels, replaces a running fade or ramp
+ * @param ticks duration in scheduler ticks, 0 sets the target at once
+ */
+void FADE_To(uint16_t red, uint16_t green, uint16_t blue, uint16_t white, uint16_t ticks);
+
+/**
+ * Stop the fade, the outputs keep their current levels; a ramp runs on
+ */
+void FADE_Stop(void);
+
+/**
+ * @return a fade is running
+ */
+bool FADE_IsActive(void);
+
+/**
+ * One fade step, scheduler task with a period of 1 tick
+ */
+void FADE_Task(void);
+
+/**
+ * Start a trajectory from the current output levels, replaces a running
+ * fade or ramp; FADE_To() and RAMP_To() start theirs here
+ * @param mode task that steps it
+ * @param steps duration in steps of that task, 0 sets the target at once
+ */
+void FADE_Start(FadeMode_t mode, uint16_t red, uint16_t green, uint16_t blue, uint16_t white, uint32_t steps);
+
+/**
+ * Stop the trajectory if it runs in a mode
+ */
+void FADE_StopMode(FadeMode_t mode);
+
+/**
+ * @return a trajectory runs in a mode
+ */
+bool FADE_IsRunning(FadeMode_t mode);
+
+/**
+ * One step of the trajectory if it runs in a mode
+ */
+void FADE_Step(FadeMode_t mode);
+
+#endif // FADE_H
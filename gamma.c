@@ -0,0 +1,34 @@
+/*
+ * CIE 1931 lightness curve, generated by host/gen_gamma.c - do not edit
+ */
+
+#include "gamma.h"
+
+// level of every fourth brightness, then of full scale
+const uint16_t gammaTable[GAMMA_KNOTS] = {
+    0x0000, 0x0072, 0x00E4, 0x0155, 0x01C7, 0x0239, 0x02B1, 0x0339,  //   0 -  28
+    0x03D1, 0x047B, 0x0538, 0x0608, 0x06ED, 0x07E8, 0x08F9, 0x0A21,  //  32 -  60
+    0x0B62, 0x0CBD, 0x0E32, 0x0FC3, 0x1170, 0x133A, 0x1522, 0x172A,  //  64 -  92
+    0x1952, 0x1B9C, 0x1E07, 0x2096, 0x2349, 0x2622, 0x2920, 0x2C45,  //  96 - 124
+    0x2F93, 0x3309, 0x36A9, 0x3A75, 0x3E6C, 0x4291, 0x46E3, 0x4B64,  // 128 - 156
+    0x5015, 0x54F6, 0x5A0A, 0x5F50, 0x64CA, 0x6A79, 0x705D, 0x7678,  // 160 - 188
+    0x7CCB, 0x8356, 0x8A1B, 0x911A, 0x9855, 0x9FCC, 0xA781, 0xAF74,  // 192 - 220
+    0xB7A7, 0xC01A, 0xC8CE, 0xD1C4, 0xDAFE, 0xE47C, 0xEE40, 0xF849,  // 224 - 252
+    0xFFFF                                                           // 255
+};
+
+uint16_t GAMMA_Level(uint8_t brightness)
+{
+    uint8_t knot = brightness >> 2;
+    uint8_t fraction = brightness & 3;
+    uint8_t weight;
+
+    if(brightness == 0xFF) {
+        return gammaTable[GAMMA_KNOTS - 1];
+    }
+
+    // 1/256 of the segment, the last one takes three steps to full scale (0, 85, 171)
+    weight = (uint8_t)(knot == GAMMA_KNOTS - 2 ? fraction * 85 + (fraction >> 1) : fraction << 6);
+    return gammaTable[knot] +
+           (uint16_t)(((uint32_t)(gammaTable[knot + 1] - gammaTable[knot]) * weight) >> 8);
+}
@@ -0,0 +1,36 @@
+/*
+ * Perceptual brightness
+ *
+ * Maps a logical 0..255 brightness to an output level along the CIE 1931
+ * lightness curve, so equal brightness steps look equal. The curve is
+ * generated by host/gen_gamma.c: flash holds the level of every fourth
+ * brightness and of full scale, 65 words of table instead of 256, and
+ * GAMMA_Level() interpolates between them: the 16 bit rise of the segment
+ * times an 8 bit weight, one 32 bit multiply in the XC8 runtime, the one
+ * the duty scaling of the output stage links in anyway. The straight
+ * segments are at most 9 levels (0.4 %) above the curve and still rise on
+ * every step.
+ */
+
+#ifndef GAMMA_H
+#define GAMMA_H
+
+#include <stdint.h>
+
+// brightness 0, 4, .. 252 and 255
+#define GAMMA_KNOTS     65
+
+/**
+ * Output level (0..OUTPUT_LEVEL_MAX) of the knots of the curve
+ */
+extern const uint16_t gammaTable[GAMMA_KNOTS];
+
+/**
+ * @return output level of a logical brightness
+ */
+uint16_t GAMMA_Level(uint8_t brightness);
+
+// output level of a logical 0..255 brightness
+#define GAMMA_LEVEL(brightness)     GAMMA_Level((uint8_t)(brightness))
+
+#endif // GAMMA_H
@@ -0,0 +1,20 @@
+/*
+ * Driver code before the TMR2_DutyScale change, for comparison in bench_hot
+ *
+ * Built as the firmware is for the benchmarks, so its multiply and divide
+ * are counted the same way.
+ */
+
+#include <xc.h>
+
+void baseline_PWM1_LoadDutyValue(uint16_t dutyValue)
+{
+    CCPR1H = dutyValue * PR2 / 0xFF;
+    CCPR1L = 0x0FF;
+}
+
+void baseline_PWM5_LoadDutyValue(uint16_t dutyValue)
+{
+    PWM5DCH = dutyValue * PR2 / 0xFF;
+    PWM5DCL = 0x00;
+}
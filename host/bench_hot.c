@@ -0,0 +1,293 @@
+/*
+ * Cost of the hot paths: the duty loaders, the output stage, its period ISR,
+ * the fade and ramp steps, the effect random numbers, the weather and the
+ * colour engine
+ *
+ *     ./bench_hot [-s scale]
+ *
+ * Every routine runs BENCH_CALLS times from a fixed state. SFR accesses are
+ * counted through the host register file. mul / div are the multiplies and
+ * divides left after the compiler turned those by a power of two (and by 3,
+ * 5 or 9) into shifts and adds, each one an XC8 runtime call on the PIC16,
+ * which has no hardware multiplier: the firmware is built for the
+ * benchmarks at -Os, which keeps a constant divide a divide, and every
+ * multiply or divide instruction counts itself, see the Makefile. These
+ * counts are exact and the same on every x86-64 host. The wall time is host
+ * time, only comparable between rows and between runs on the same machine.
+ *
+ * Exits non-zero if a routine makes more SFR accesses, multiplies or
+ * divides than its budget, if the baselines count no divide (the counting
+ * does not work on this host) or if the duty loaders round more than a
+ * count off the old divide. The time budgets only gate with -s, times the
+ * scale given for the machine at hand: they are host nanoseconds, and on a
+ * shared or loaded host they fail at random. The accuracy of the colour
+ * engine is test_colour's.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "mcc_generated_files/mcc.h"
+#include "output.h"
+#include "fade.h"
+#include "ramp.h"
+#include "gamma.h"
+#include "prng.h"
+#include "weather.h"
+#include "colour.h"
+
+#define BENCH_CALLS     (1UL << 22)
+
+// the standard profile, PR2 191
+static const OutputTiming_t standardTiming = { 0xBF, 0x24, 0, 25 };
+
+// multiplies and divides of the firmware so far, counted by the instrumented build
+unsigned long bench_muls;
+unsigned long bench_divs;
+
+// driver code before the TMR2_DutyScale change, see bench_baseline.c
+void baseline_PWM1_LoadDutyValue(uint16_t dutyValue);
+void baseline_PWM5_LoadDutyValue(uint16_t dutyValue);
+
+static void setupOutput(void)
+{
+    TMR2_Initialize();
+    OUTPUT_Initialize();
+    OUTPUT_SetTiming(&standardTiming);
+    OUTPUT_Commit();
+    OUTPUT_PeriodISR();
+    // the switch ends the period, nothing runs the timer here
+    TMR2 = 0;
+}
+
+// every channel dithered at an odd fraction, the steady state of a level
+static void setupDither(void)
+{
+    setupOutput();
+    OUTPUT_SetRGBW(GAMMA_LEVEL(101), GAMMA_LEVEL(67), GAMMA_LEVEL(149), GAMMA_LEVEL(203));
+    OUTPUT_Commit();
+    OUTPUT_PeriodISR();
+}
+
+// a fade longer than the run
+static void setupFade(void)
+{
+    setupOutput();
+    FADE_Initialize();
+    FADE_Start(FADE_MODE_FADE, OUTPUT_LEVEL_MAX, 40000, 3000, OUTPUT_LEVEL_MAX, 0x1000000UL);
+}
+
+// a sunrise longer than the run
+static void setupRamp(void)
+{
+    setupOutput();
+    FADE_Initialize();
+    RAMP_To(OUTPUT_LEVEL_MAX, 40000, 3000, OUTPUT_LEVEL_MAX, 0x1000000UL);
+}
+
+static void runLoadDutyValue1(uint16_t i) { PWM1_LoadDutyValue((uint8_t)i); }
+static void runLoadDutyValue5(uint16_t i) { PWM5_LoadDutyValue((uint8_t)i); }
+static void runBaseline1(uint16_t i) { baseline_PWM1_LoadDutyValue((uint8_t)i); }
+static void runBaseline5(uint16_t i) { baseline_PWM5_LoadDutyValue((uint8_t)i); }
+static void runLoadDuty10_1(uint16_t i) { PWM1_LoadDuty10(i & 0x3FF); }
+static void runLoadDuty10_5(uint16_t i) { PWM5_LoadDuty10(i & 0x3FF); }
+
+static void runSetRGBW(uint16_t i)
+{
+    OUTPUT_SetRGBW(i, i + 1, i + 2, i + 3);
+}
+
+static void runSetCommit(uint16_t i)
+{
+    OUTPUT_SetRGBW(i, i + 1, i + 2, i + 3);
+    OUTPUT_Commit();
+}
+
+static void runPeriodISR(uint16_t i)
+{
+    (void)i;
+    OUTPUT_PeriodISR();
+}
+
+// a new set of levels every tick, the ISR takes it over
+static void runCommitISR(uint16_t i)
+{
+    OUTPUT_SetRGBW(i << 4, i << 5, i << 6, i << 7);
+    OUTPUT_Commit();
+    OUTPUT_PeriodISR();
+}
+
+static void runFadeTo(uint16_t i)
+{
+    FADE_To(i, ~i, i << 3, i >> 1, (i & 0xFF) + 1);
+}
+
+static void runFadeTask(uint16_t i)
+{
+    (void)i;
+    FADE_Task();
+}
+
+static void runRampTo(uint16_t i)
+{
+    RAMP_To(i, ~i, i << 3, i >> 1, 0x10000UL + i);
+}
+
+static void runRampTask(uint16_t i)
+{
+    (void)i;
+    RAMP_Task();
+}
+
+// a storm, mostly under its clouds
+static void setupWeather(void)
+{
+    setupDither();
+    WEATHER_Initialize();
+}
+
+static void runWeatherTask(uint16_t i)
+{
+    (void)i;
+    WEATHER_Task(WEATHER_STORM);
+}
+
+static void runPrngNext(uint16_t i)
+{
+    (void)i;
+    PRNG_Next();
+}
+
+// the random colour effect draws two of these, worst case a bound just over a power of two
+static void runPrngBelow(uint16_t i)
+{
+    PRNG_Below((uint8_t)(i & 1) ? 40 : 5);
+}
+
+// a hue sweep over every saturation and brightness
+static void runHsvToLevels(uint16_t i)
+{
+    uint16_t levels[OUTPUT_CHANNEL_COUNT];
+
+    COLOUR_HsvToLevels(i * 41, (uint8_t)(i >> 3), (uint8_t)i, levels);
+}
+
+// the baselines are for comparison only
+#define NO_BUDGET       -1.0
+
+typedef struct {
+    const char *name;
+    void (*setup)(void);
+    void (*run)(uint16_t i);
+    double sfrBudget;       // SFR accesses per call at most, on average
+    double mulBudget;       // multiplies per call at most, on average
+    double divBudget;       // divides per call at most, on average
+    double nsBudget;        // host ns per call at most, with -s 1
+} BenchCase_t;
+
+static const BenchCase_t cases[] = {
+    { "baseline PWM1_LoadDutyValue", setupOutput,  runBaseline1,       NO_BUDGET, NO_BUDGET, NO_BUDGET, NO_BUDGET },
+    { "PWM1_LoadDutyValue",          setupOutput,  runLoadDutyValue1,  2,    1,    0,    20 },
+    { "baseline PWM5_LoadDutyValue", setupOutput,  runBaseline5,       NO_BUDGET, NO_BUDGET, NO_BUDGET, NO_BUDGET },
+    { "PWM5_LoadDutyValue",          setupOutput,  runLoadDutyValue5,  2,    1,    0,    20 },
+    { "PWM1_LoadDuty10",             setupOutput,  runLoadDuty10_1,    2,    0,    0,    20 },
+    { "PWM5_LoadDuty10",             setupOutput,  runLoadDuty10_5,    2,    0,    0,    20 },
+    { "OUTPUT_SetRGBW",              setupOutput,  runSetRGBW,         0,    4,    0,    25 },
+    { "OUTPUT_SetRGBW + Commit",     setupOutput,  runSetCommit,       1.5,  4,    0,    30 },
+    { "OUTPUT_PeriodISR, dither",    setupDither,  runPeriodISR,       5,    0,    0,    80 },
+    { "OUTPUT_Commit + PeriodISR",   setupOutput,  runCommitISR,       8.9,  4,    0,   130 },
+    { "FADE_To",                     setupOutput,  runFadeTo,          0,    0,    4,    60 },
+    { "FADE_Task",                   setupFade,    runFadeTask,        0,    4,    0,    50 },
+    { "RAMP_To",                     setupOutput,  runRampTo,          0,    0,    4,    50 },
+    { "RAMP_Task",                   setupRamp,    runRampTask,        0,    4,    0,    40 },
+    { "PRNG_Next",                   setupOutput,  runPrngNext,        0,    0,    0,    10 },
+    { "PRNG_Below",                  setupOutput,  runPrngBelow,       0,    0,    0,    30 },
+    { "WEATHER_Task, storm",         setupWeather, runWeatherTask,     0,    0.1,  0,    20 },
+    { "COLOUR_HsvToLevels",          setupOutput,  runHsvToLevels,     0,    4.01, 0,    25 },
+};
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int main(int argc, char **argv)
+{
+    double scale = 0;
+    unsigned maxError = 0;
+    unsigned failures = 0;
+    double baselineDivs = INFINITY;
+    int option;
+
+    while((option = getopt(argc, argv, "s:")) != -1) {
+        if(option != 's') {
+            fprintf(stderr, "usage: %s [-s scale]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+        scale = atof(optarg);
+    }
+
+    printf("%-30s %8s %5s %5s %9s   %s\n", "routine", "sfr/call", "mul", "div", "ns/call", "budget");
+
+    for(size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        const BenchCase_t *bc = &cases[c];
+        unsigned long accesses, muls, divs;
+        double start, sfr, mul, div, ns;
+        bool over;
+
+        bc->setup();
+        accesses = host_sfr_accesses;
+        muls = bench_muls;
+        divs = bench_divs;
+        start = now_ns();
+        for(unsigned long i = 0; i < BENCH_CALLS; i++) {
+            bc->run((uint16_t)i);
+        }
+        ns = (now_ns() - start) / BENCH_CALLS;
+        sfr = (double)(host_sfr_accesses - accesses) / BENCH_CALLS;
+        mul = (double)(bench_muls - muls) / BENCH_CALLS;
+        div = (double)(bench_divs - divs) / BENCH_CALLS;
+
+        if(bc->sfrBudget == NO_BUDGET) {
+            baselineDivs = fmin(baselineDivs, div);
+        }
+        over = bc->sfrBudget != NO_BUDGET &&
+               (sfr > bc->sfrBudget || mul > bc->mulBudget || div > bc->divBudget ||
+                (scale && ns > bc->nsBudget * scale));
+        failures += over;
+        printf("%-30s %8.2f %5.2f %5.2f %9.2f   ", bc->name, sfr, mul, div, ns);
+        if(bc->sfrBudget == NO_BUDGET) {
+            printf("-\n");
+        } else {
+            printf("%4.2f sfr %4.2f mul %4.2f div", bc->sfrBudget, bc->mulBudget, bc->divBudget);
+            if(scale) {
+                printf(" %4.0f ns", bc->nsBudget * scale);
+            }
+            printf("%s\n", over ? "  OVER" : "");
+        }
+    }
+
+    // the shift based scale may round differently from the divide
+    for(uint16_t duty = 0; duty < 256; duty++) {
+        baseline_PWM1_LoadDutyValue(duty);
+        unsigned expected = host_sfr.sfr_CCPR1H;
+        PWM1_LoadDutyValue(duty);
+        unsigned error = abs((int)host_sfr.sfr_CCPR1H - (int)expected);
+        if(error > maxError) {
+            maxError = error;
+        }
+    }
+    printf("\nmax difference to baseline: %u count(s)\n", maxError);
+    if(baselineDivs < 1) {
+        printf("the baselines count %.2f divides per call, no multiply or divide is counted here\n", baselineDivs);
+    }
+    if(failures) {
+        printf("%u routine(s) over budget\n", failures);
+    }
+
+    return (maxError > 1 || baselineDivs < 1 || failures) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
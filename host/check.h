@@ -0,0 +1,37 @@
+/*
+ * Assertions of the host tests
+ *
+ * A failed CHECK() prints its location and message and the test goes on,
+ * so one run shows every failure. A test exits with check_exit().
+ */
+
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static unsigned checkFailures;
+
+#define CHECK(condition, ...) \
+    do { \
+        if(!(condition)) { \
+            checkFailures++; \
+            printf("%s:%d: ", __FILE__, __LINE__); \
+            printf(__VA_ARGS__); \
+            putchar('\n'); \
+        } \
+    } while(0)
+
+/**
+ * Report the result of a test
+ * @param name test name
+ * @return exit status of the test
+ */
+static inline int check_exit(const char *name)
+{
+    printf("%-24s %s\n", name, checkFailures ? "FAILED" : "ok");
+    return checkFailures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+#endif // CHECK_H
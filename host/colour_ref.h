@@ -0,0 +1,45 @@
+/*
+ * Floating point reference of the colour engine for the host tests
+ *
+ * Textbook HSV to RGB in doubles on the gamma mapped value, then the
+ * smallest of the three moved to white, as colour.h describes it.
+ */
+
+#ifndef COLOUR_REF_H
+#define COLOUR_REF_H
+
+#include <math.h>
+#include "output.h"
+#include "gamma.h"
+
+/**
+ * Exact output levels of a colour, see COLOUR_HsvToLevels()
+ * @param rgbw OUTPUT_CHANNEL_COUNT levels, indexed by OutputChannel_t
+ */
+static void colour_reference(uint16_t hue, uint8_t saturation, uint8_t value, double *rgbw)
+{
+    double v = GAMMA_LEVEL(value);
+    double c = v * saturation / 255.0;
+    double h = hue * 6.0 / 65536.0;
+    double x = c * (1.0 - fabs(fmod(h, 2.0) - 1.0));
+    double r, g, b, w;
+
+    switch((int)h) {
+        case 0:  r = c; g = x; b = 0; break;
+        case 1:  r = x; g = c; b = 0; break;
+        case 2:  r = 0; g = c; b = x; break;
+        case 3:  r = 0; g = x; b = c; break;
+        case 4:  r = x; g = 0; b = c; break;
+        default: r = c; g = 0; b = x; break;
+    }
+    r += v - c;
+    g += v - c;
+    b += v - c;
+    w = fmin(r, fmin(g, b));
+    rgbw[OUTPUT_RED] = r - w;
+    rgbw[OUTPUT_GREEN] = g - w;
+    rgbw[OUTPUT_BLUE] = b - w;
+    rgbw[OUTPUT_WHITE] = w;
+}
+
+#endif // COLOUR_REF_H
@@ -0,0 +1,113 @@
+/*
+ * Generates ../gamma.c, the CIE 1931 lightness curve of the output stage
+ *
+ *     ./gen_gamma > ../gamma.c
+ *
+ * Logical brightness b (0..255) is taken as lightness L* = 100 * b / 255 and
+ * converted to relative luminance Y, the fraction of the PWM period:
+ *
+ *     Y = L* / 903.3                  L* <= 8
+ *     Y = ((L* + 16) / 116) ^ 3       L* >  8
+ *
+ * Only every fourth brightness and full scale go to flash, GAMMA_Level()
+ * interpolates the rest; the curve is convex, so a straight segment lies
+ * a little above it, at most 9 levels here.
+ *
+ * The curve is checked before anything is printed, interpolated as the
+ * firmware does: it must start at 0, end at full scale and rise strictly,
+ * so every logical step is a visible one.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+
+#define BRIGHTNESS_MAX  255
+#define KNOT_STEP       4
+#define GAMMA_KNOTS     (BRIGHTNESS_MAX / KNOT_STEP + 2)
+#define LEVEL_MAX       0xFFFF
+
+static double luminance(unsigned brightness)
+{
+    double lightness = 100.0 * brightness / BRIGHTNESS_MAX;
+
+    if(lightness <= 8.0) {
+        return lightness / 903.3;
+    }
+    return pow((lightness + 16.0) / 116.0, 3.0);
+}
+
+// GAMMA_Level() of ../gamma.c
+static uint16_t interpolate(const uint16_t *table, unsigned brightness)
+{
+    unsigned knot = brightness / KNOT_STEP;
+    unsigned fraction = brightness % KNOT_STEP;
+    unsigned weight = knot == GAMMA_KNOTS - 2 ? fraction * 85 + (fraction >> 1) : fraction << 6;
+
+    if(brightness == BRIGHTNESS_MAX) {
+        return table[GAMMA_KNOTS - 1];
+    }
+    return (uint16_t)(table[knot] + (((uint32_t)(table[knot + 1] - table[knot]) * weight) >> 8));
+}
+
+int main(void)
+{
+    uint16_t table[GAMMA_KNOTS];
+
+    for(unsigned i = 0; i < GAMMA_KNOTS - 1; i++) {
+        table[i] = (uint16_t)lround(luminance(i * KNOT_STEP) * LEVEL_MAX);
+    }
+    table[GAMMA_KNOTS - 1] = (uint16_t)lround(luminance(BRIGHTNESS_MAX) * LEVEL_MAX);
+
+    if(interpolate(table, 0) != 0 || interpolate(table, BRIGHTNESS_MAX) != LEVEL_MAX) {
+        fprintf(stderr, "gen_gamma: end points %u..%u\n",
+                interpolate(table, 0), interpolate(table, BRIGHTNESS_MAX));
+        return 1;
+    }
+    for(unsigned i = 1; i <= BRIGHTNESS_MAX; i++) {
+        if(interpolate(table, i) <= interpolate(table, i - 1)) {
+            fprintf(stderr, "gen_gamma: not rising at %u\n", i);
+            return 1;
+        }
+    }
+
+    printf("/*\n");
+    printf(" * CIE 1931 lightness curve, generated by host/gen_gamma.c - do not edit\n");
+    printf(" */\n");
+    printf("\n");
+    printf("#include \"gamma.h\"\n");
+    printf("\n");
+    printf("// level of every fourth brightness, then of full scale\n");
+    printf("const uint16_t gammaTable[GAMMA_KNOTS] = {\n");
+    for(unsigned i = 0; i < GAMMA_KNOTS; i += 8) {
+        unsigned end = i + 8 < GAMMA_KNOTS ? i + 8 : GAMMA_KNOTS;
+
+        printf("   ");
+        for(unsigned j = i; j < end; j++) {
+            printf(" 0x%04X%s", table[j], j == GAMMA_KNOTS - 1 ? " " : ",");
+        }
+        if(end - i == 1) {
+            printf("%*s  // %3u\n", 8 * 7, "", BRIGHTNESS_MAX);
+        } else {
+            printf("  // %3u - %3u\n", i * KNOT_STEP, (end - 1) * KNOT_STEP);
+        }
+    }
+    printf("};\n");
+    printf("\n");
+    printf("uint16_t GAMMA_Level(uint8_t brightness)\n");
+    printf("{\n");
+    printf("    uint8_t knot = brightness >> 2;\n");
+    printf("    uint8_t fraction = brightness & 3;\n");
+    printf("    uint8_t weight;\n");
+    printf("\n");
+    printf("    if(brightness == 0xFF) {\n");
+    printf("        return gammaTable[GAMMA_KNOTS - 1];\n");
+    printf("    }\n");
+    printf("\n");
+    printf("    // 1/256 of the segment, the last one takes three steps to full scale (0, 85, 171)\n");
+    printf("    weight = (uint8_t)(knot == GAMMA_KNOTS - 2 ? fraction * 85 + (fraction >> 1) : fraction << 6);\n");
+    printf("    return gammaTable[knot] +\n");
+    printf("           (uint16_t)(((uint32_t)(gammaTable[knot + 1] - gammaTable[knot]) * weight) >> 8);\n");
+    printf("}\n");
+    return 0;
+}
@@ -0,0 +1,35 @@
+/*
+ * Host register file for the XC8 <xc.h> replacement
+ */
+
+#include <xc.h>
+
+volatile HostSfrFile_t host_sfr;
+unsigned long host_sfr_accesses = 0;
+
+void (*host_sfr_hook)(volatile void *sfr);
+void (*host_delay_hook)(unsigned long us);
+void (*host_sleep_hook)(void);
+
+void host_delay_us(unsigned long us)
+{
+    if(host_delay_hook) {
+        host_delay_hook(us);
+    }
+}
+
+void host_sleep(void)
+{
+    if(host_sleep_hook) {
+        host_sleep_hook();
+    }
+}
+
+volatile void *host_sfr_access(volatile void *sfr)
+{
+    ++host_sfr_accesses;
+    if(host_sfr_hook) {
+        host_sfr_hook(sfr);
+    }
+    return sfr;
+}
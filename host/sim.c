@@ -0,0 +1,735 @@
+/*
+ * Register level simulation of the PIC16F18313 peripherals, see sim.h
+ *
+ * Writes are not visible to the register file hooks, which run before the
+ * access. Watched registers are compared with a shadow copy at the next
+ * access (or SLEEP / delay) instead, so a write takes effect one
+ * instruction late, and writing the same value again goes unnoticed.
+ * NVMCON2 reads back as zero, so each unlock write is seen.
+ */
+
+#include <setjmp.h>
+#include <stdlib.h>
+#include <string.h>
+#include <xc.h>
+#include "sim.h"
+
+#define NEVER               UINT64_MAX
+#define REG(field)          offsetof(HostSfrFile_t, field)
+#define NO_ACCESS           SIZE_MAX
+
+// duty records kept by default, 16 MB
+#define DEFAULT_LOG_LIMIT   (1UL << 20)
+
+// the firmware, main() of main.c is built as firmware_main()
+void firmware_main(void);
+void INTERRUPT_InterruptManager(void);
+extern unsigned char eeprom_values[SIM_EEPROM_IMAGE_SIZE];
+
+typedef enum Watch {
+    WATCH_NONE = 0,
+    WATCH_TIMER,        // TMR2 clock, period or gating
+    WATCH_TMR2,
+    WATCH_DUTY,         // PWM duty, mode or gating
+    WATCH_NVMCON1,
+    WATCH_NVMCON2,
+    WATCH_IOC,
+    WATCH_INTERRUPT     // enables and flags
+} Watch_t;
+
+static const uint8_t watch[sizeof(HostSfrFile_t)] = {
+    [REG(sfr_PR2)]      = WATCH_TIMER,
+    [REG(sfr_T2CON)]    = WATCH_TIMER,
+    [REG(sfr_OSCCON1)]  = WATCH_TIMER,
+    [REG(sfr_PMD1)]     = WATCH_TIMER,
+    [REG(sfr_TMR2)]     = WATCH_TMR2,
+    [REG(sfr_CCP1CON)]  = WATCH_DUTY,
+    [REG(sfr_CCPR1H)]   = WATCH_DUTY,
+    [REG(sfr_CCPR1L)]   = WATCH_DUTY,
+    [REG(sfr_CCP2CON)]  = WATCH_DUTY,
+    [REG(sfr_CCPR2H)]   = WATCH_DUTY,
+    [REG(sfr_CCPR2L)]   = WATCH_DUTY,
+    [REG(sfr_PWM5CON)]  = WATCH_DUTY,
+    [REG(sfr_PWM5DCH)]  = WATCH_DUTY,
+    [REG(sfr_PWM5DCL)]  = WATCH_DUTY,
+    [REG(sfr_PWM6CON)]  = WATCH_DUTY,
+    [REG(sfr_PWM6DCH)]  = WATCH_DUTY,
+    [REG(sfr_PWM6DCL)]  = WATCH_DUTY,
+    [REG(sfr_PMD3)]     = WATCH_DUTY,
+    [REG(sfr_NVMCON1)]  = WATCH_NVMCON1,
+    [REG(sfr_NVMCON2)]  = WATCH_NVMCON2,
+    [REG(sfr_IOCAF)]    = WATCH_IOC,
+    [REG(sfr_INTCON)]   = WATCH_INTERRUPT,
+    [REG(sfr_PIE0)]     = WATCH_INTERRUPT,
+    [REG(sfr_PIR0)]     = WATCH_INTERRUPT,
+    [REG(sfr_PIE1)]     = WATCH_INTERRUPT,
+    [REG(sfr_PIR1)]     = WATCH_INTERRUPT,
+    [REG(sfr_PIE2)]     = WATCH_INTERRUPT,
+    [REG(sfr_PIR2)]     = WATCH_INTERRUPT
+};
+
+typedef struct Action {
+    sim_time_t time;
+    void (*action)(void *arg);
+    void *arg;
+} Action_t;
+
+static volatile uint8_t *const sfr = (volatile uint8_t *)&host_sfr;
+static uint8_t shadow[sizeof(HostSfrFile_t)];
+static size_t lastAccess;
+
+static sim_time_t now;
+static sim_time_t nextEvent;
+static sim_time_t cycle;            // instruction cycle
+static bool requested;              // enabled interrupt flag set, wakes SLEEP
+static bool pending;                // and GIE set
+static sim_time_t stopTime;
+static jmp_buf stopJump;
+static bool inInterrupt;
+static bool sleeping;
+static bool deadlocked;
+static SimStats_t stats;
+
+// actions, sorted latest first
+static Action_t *actions;
+static size_t actionCount;
+static size_t actionCapacity;
+
+// TMR2, tickLength is 0 while it is stopped and heldCount keeps the count
+static sim_time_t tickLength;
+static sim_time_t periodLength;
+static int64_t periodStart;
+static uint8_t heldCount;
+static uint8_t postscaleCount;
+static bool latchPending;
+static sim_time_t timerEventTime;   // next match that matters, see timerNext()
+static uint8_t timerEventPeriods;
+
+// latched PWM outputs
+static uint16_t activeDuty[SIM_PWM_COUNT];
+static uint16_t activePeriod;
+static double onTime[SIM_PWM_COUNT];
+static sim_time_t onTimeSince;
+static void (*dutyHook)(const SimDutyChange_t *change);
+static void (*periodHook)(const SimPeriod_t *period);
+static void (*buttonHook)(sim_time_t time, bool level);
+static SimDutyChange_t *dutyLog;
+static size_t logCount;
+static size_t logCapacity;
+static size_t logLimit = DEFAULT_LOG_LIMIT;
+
+// NVM
+static uint8_t eeprom[SIM_EEPROM_SIZE];
+static uint8_t unlockStage;
+static sim_time_t writeDone;
+static uint8_t writeAddress;
+static uint8_t writeData;
+
+// after every change of an interrupt enable or flag
+static void updateInterrupt(void)
+{
+    requested = (host_sfr.sfr_PIE0.IOCIE && host_sfr.sfr_PIR0.IOCIF)
+             || (host_sfr.sfr_INTCON.PEIE
+                 && ((host_sfr.sfr_PIE1.TMR2IE && host_sfr.sfr_PIR1.TMR2IF)
+                  || (host_sfr.sfr_PIE2.NVMIE && host_sfr.sfr_PIR2.NVMIF)));
+    pending = requested && host_sfr.sfr_INTCON.GIE;
+}
+
+// set a flag from the hardware side
+#define SET_FLAG(field, flag) \
+    do { \
+        host_sfr.field.flag = 1; \
+        shadow[REG(field)] = sfr[REG(field)]; \
+        updateInterrupt(); \
+    } while(0)
+
+/*
+ * TMR2
+ */
+
+static uint8_t timerCount(void)
+{
+    if(!tickLength) {
+        return heldCount;
+    }
+    // less than a period has passed since periodStart
+    return (uint8_t)((uint32_t)((int64_t)now - periodStart) / (uint32_t)tickLength);
+}
+
+static void timerNext(void)
+{
+    uint8_t postscale = host_sfr.sfr_T2CON.T2OUTPS + 1;
+
+    if(!periodLength) {
+        timerEventTime = NEVER;
+        return;
+    }
+    // single periods only while a duty waits for the latch or they are traced
+    timerEventPeriods = (latchPending || periodHook || postscaleCount >= postscale)
+                      ? 1 : postscale - postscaleCount;
+    timerEventTime = (sim_time_t)(periodStart + (int64_t)(timerEventPeriods * periodLength));
+}
+
+// restart the count from the current settings
+static void timerSync(uint8_t count)
+{
+    static const uint8_t prescale[4] = { 1, 4, 16, 64 };
+    uint8_t period = host_sfr.sfr_PR2;
+    bool running = host_sfr.sfr_T2CON.TMR2ON && !host_sfr.sfr_PMD1.TMR2MD
+                && !(sleeping && !host_sfr.sfr_CPUDOZE.IDLEN);
+
+    cycle = (sim_time_t)4 << host_sfr.sfr_OSCCON1.NDIV;
+    if(!running) {
+        heldCount = count;
+        tickLength = 0;
+        periodLength = 0;
+        return;
+    }
+    tickLength = prescale[host_sfr.sfr_T2CON.T2CKPS] * cycle;
+    periodLength = ((sim_time_t)period + 1) * tickLength;
+    // past PR2 it counts up to the overflow first
+    periodStart = (int64_t)now - (int64_t)((count <= period) ? count : count - 256) * (int64_t)tickLength;
+}
+
+/*
+ * PWM
+ */
+
+static uint16_t registerDuty(SimPwm_t pwm)
+{
+    switch(pwm) {
+        case SIM_CCP1:
+            if(!host_sfr.sfr_CCP1CON.CCP1EN || host_sfr.sfr_PMD3.CCP1MD || host_sfr.sfr_CCP1CON.CCP1MODE != 0xF) {
+                return 0;
+            }
+            return host_sfr.sfr_CCP1CON.CCP1FMT
+                ? (uint16_t)((host_sfr.sfr_CCPR1H << 2) | (host_sfr.sfr_CCPR1L >> 6))
+                : (uint16_t)(((host_sfr.sfr_CCPR1H & 0x03) << 8) | host_sfr.sfr_CCPR1L);
+        case SIM_CCP2:
+            if(!host_sfr.sfr_CCP2CON.CCP2EN || host_sfr.sfr_PMD3.CCP2MD || host_sfr.sfr_CCP2CON.CCP2MODE != 0xF) {
+                return 0;
+            }
+            return host_sfr.sfr_CCP2CON.CCP2FMT
+                ? (uint16_t)((host_sfr.sfr_CCPR2H << 2) | (host_sfr.sfr_CCPR2L >> 6))
+                : (uint16_t)(((host_sfr.sfr_CCPR2H & 0x03) << 8) | host_sfr.sfr_CCPR2L);
+        case SIM_PWM5:
+            if(!host_sfr.sfr_PWM5CON.PWM5EN || host_sfr.sfr_PMD3.PWM5MD) {
+                return 0;
+            }
+            return (uint16_t)((host_sfr.sfr_PWM5DCH << 2) | (host_sfr.sfr_PWM5DCL >> 6));
+        case SIM_PWM6:
+            if(!host_sfr.sfr_PWM6CON.PWM6EN || host_sfr.sfr_PMD3.PWM6MD) {
+                return 0;
+            }
+            return (uint16_t)((host_sfr.sfr_PWM6DCH << 2) | (host_sfr.sfr_PWM6DCL >> 6));
+        default:
+            return 0;
+    }
+}
+
+static double dutyFraction(uint16_t duty, uint16_t period)
+{
+    return (duty >= period) ? 1.0 : (double)duty / period;
+}
+
+static void integrateOnTime(void)
+{
+    double span = SIM_TO_SECONDS(now - onTimeSince);
+
+    for(uint8_t i = 0; i < SIM_PWM_COUNT; i++) {
+        onTime[i] += dutyFraction(activeDuty[i], activePeriod) * span;
+    }
+    onTimeSince = now;
+}
+
+static void recordDuty(uint8_t pwm, uint16_t duty, uint16_t period)
+{
+    SimDutyChange_t change = { now, pwm, duty, period };
+
+    stats.dutyChanges++;
+    if(dutyHook) {
+        dutyHook(&change);
+    }
+    if(logCount >= logLimit) {
+        return;
+    }
+    if(logCount == logCapacity) {
+        size_t capacity = logCapacity ? logCapacity * 2 : 4096;
+        SimDutyChange_t *grown = realloc(dutyLog, capacity * sizeof(*dutyLog));
+
+        if(!grown) {
+            return;
+        }
+        dutyLog = grown;
+        logCapacity = capacity;
+    }
+    dutyLog[logCount++] = change;
+}
+
+// double buffered duties move to the outputs at the period match
+static void latchDuties(void)
+{
+    uint16_t period = (uint16_t)(((uint16_t)host_sfr.sfr_PR2 + 1) * 4);
+
+    integrateOnTime();
+    for(uint8_t i = 0; i < SIM_PWM_COUNT; i++) {
+        uint16_t duty = registerDuty((SimPwm_t)i);
+
+        if(duty != activeDuty[i] || period != activePeriod) {
+            activeDuty[i] = duty;
+            recordDuty(i, duty, period);
+        }
+    }
+    activePeriod = period;
+    latchPending = false;
+}
+
+static void timerEvent(void)
+{
+    uint8_t postscale = host_sfr.sfr_T2CON.T2OUTPS + 1;
+
+    periodStart += (int64_t)(timerEventPeriods * periodLength);
+    if(latchPending) {
+        latchDuties();
+    }
+    if(periodHook) {
+        SimPeriod_t period = { now, tickLength / 4, activePeriod, { 0 } };
+
+        memcpy(period.duty, activeDuty, sizeof(period.duty));
+        periodHook(&period);
+    }
+    postscaleCount += timerEventPeriods;
+    if(postscaleCount >= postscale) {
+        postscaleCount = 0;
+        SET_FLAG(sfr_PIR1, TMR2IF);
+    }
+}
+
+/*
+ * NVM
+ */
+
+static void readNvm(void)
+{
+    uint16_t address = (uint16_t)((host_sfr.sfr_NVMADRH << 8) | host_sfr.sfr_NVMADRL);
+
+    if(host_sfr.sfr_PMD0.NVMMD) {
+        stats.eepromFaults++;
+        host_sfr.sfr_NVMDATL = 0;
+    } else if(!host_sfr.sfr_NVMCON1.NVMREGS) {
+        host_sfr.sfr_NVMDATL = 0xFF;    // program flash is not modelled, reads erased
+        host_sfr.sfr_NVMDATH = 0x3F;
+    } else if((address & 0xFF00) == SIM_EEPROM_ADDRESS) {
+        host_sfr.sfr_NVMDATL = eeprom[address & 0xFF];
+        host_sfr.sfr_NVMDATH = 0;
+    } else {
+        host_sfr.sfr_NVMDATL = 0;
+        host_sfr.sfr_NVMDATH = 0;
+    }
+    host_sfr.sfr_NVMCON1.RD = 0;
+}
+
+static void startNvmWrite(void)
+{
+    uint16_t address = (uint16_t)((host_sfr.sfr_NVMADRH << 8) | host_sfr.sfr_NVMADRL);
+    bool eepromWrite = host_sfr.sfr_NVMCON1.NVMREGS && (address & 0xFF00) == SIM_EEPROM_ADDRESS;
+
+    if(host_sfr.sfr_PMD0.NVMMD || !host_sfr.sfr_NVMCON1.WREN || unlockStage != 2
+            || !eepromWrite || writeDone != NEVER) {
+        // locked, gated off, busy or flash: nothing is written
+        stats.eepromFaults++;
+        host_sfr.sfr_NVMCON1.WR = 0;
+    } else {
+        writeAddress = (uint8_t)address;
+        writeData = host_sfr.sfr_NVMDATL;
+        writeDone = now + SIM_EEPROM_WRITE_TIME;
+    }
+    unlockStage = 0;
+}
+
+static void writeEvent(void)
+{
+    eeprom[writeAddress] = writeData;
+    writeDone = NEVER;
+    stats.eepromWrites++;
+    host_sfr.sfr_NVMCON1.WR = 0;
+    shadow[REG(sfr_NVMCON1)] = sfr[REG(sfr_NVMCON1)];
+    SET_FLAG(sfr_PIR2, NVMIF);
+}
+
+/*
+ * PORTA
+ */
+
+static void setButton(void *arg)
+{
+    bool level = arg != NULL;
+
+    if(host_sfr.sfr_PORTA.RA5 == level) {
+        return;
+    }
+    host_sfr.sfr_PORTA.RA5 = level;
+    shadow[REG(sfr_PORTA)] = sfr[REG(sfr_PORTA)];
+    if(buttonHook) {
+        buttonHook(now, level);
+    }
+    if(!host_sfr.sfr_PMD0.IOCMD && (level ? host_sfr.sfr_IOCAP.IOCAP5 : host_sfr.sfr_IOCAN.IOCAN5)) {
+        host_sfr.sfr_IOCAF.IOCAF5 = 1;
+        shadow[REG(sfr_IOCAF)] = sfr[REG(sfr_IOCAF)];
+        SET_FLAG(sfr_PIR0, IOCIF);
+    }
+}
+
+/*
+ * Virtual time
+ */
+
+static void updateNextEvent(void)
+{
+    sim_time_t next = stopTime;
+
+    timerNext();
+    if(timerEventTime < next) {
+        next = timerEventTime;
+    }
+    if(writeDone < next) {
+        next = writeDone;
+    }
+    if(actionCount && actions[actionCount - 1].time < next) {
+        next = actions[actionCount - 1].time;
+    }
+    nextEvent = next;
+}
+
+static void processUntil(sim_time_t time)
+{
+    while(nextEvent <= time) {
+        now = nextEvent;
+        if(timerEventTime <= now) {
+            timerEvent();
+        }
+        if(writeDone <= now) {
+            writeEvent();
+        }
+        while(actionCount && actions[actionCount - 1].time <= now) {
+            Action_t due = actions[--actionCount];
+
+            due.action(due.arg);
+        }
+        // actions due at the stop time still run
+        if(now >= stopTime) {
+            longjmp(stopJump, 1);
+        }
+        updateNextEvent();
+    }
+    now = time;
+}
+
+// apply the firmware write of the previous access
+static void commit(void)
+{
+    size_t offset = lastAccess;
+    uint8_t value;
+
+    if(offset == NO_ACCESS) {
+        return;
+    }
+    lastAccess = NO_ACCESS;
+    value = sfr[offset];
+    if(value == shadow[offset]) {
+        return;
+    }
+
+    switch(watch[offset]) {
+        case WATCH_TIMER: {
+            uint8_t count = timerCount();
+
+            if(offset == REG(sfr_T2CON)) {
+                postscaleCount = 0;
+            }
+            timerSync(count);
+            // a new period length reaches the outputs at the match
+            latchPending = true;
+            updateNextEvent();
+            break;
+        }
+        case WATCH_TMR2:
+            postscaleCount = 0;
+            timerSync(value);
+            updateNextEvent();
+            break;
+        case WATCH_DUTY:
+            latchPending = true;
+            updateNextEvent();
+            break;
+        case WATCH_NVMCON1:
+            if(host_sfr.sfr_NVMCON1.RD) {
+                readNvm();
+            }
+            if(host_sfr.sfr_NVMCON1.WR && !(shadow[offset] & 0x02)) {
+                startNvmWrite();
+                updateNextEvent();
+            }
+            break;
+        case WATCH_NVMCON2:
+            if(value == 0x55) {
+                unlockStage = 1;
+            } else {
+                unlockStage = (value == 0xAA && unlockStage == 1) ? 2 : 0;
+            }
+            host_sfr.sfr_NVMCON2 = 0;
+            break;
+        case WATCH_IOC:
+            host_sfr.sfr_PIR0.IOCIF = (host_sfr.sfr_IOCAF.reg & 0x3F) != 0;
+            shadow[REG(sfr_PIR0)] = sfr[REG(sfr_PIR0)];
+            updateInterrupt();
+            break;
+        case WATCH_INTERRUPT:
+            updateInterrupt();
+            break;
+        default:
+            break;
+    }
+    shadow[offset] = sfr[offset];
+}
+
+static void interrupt(void)
+{
+    if(!pending || inInterrupt) {
+        return;
+    }
+    inInterrupt = true;
+    stats.interrupts++;
+    INTERRUPT_InterruptManager();
+    inInterrupt = false;
+    commit();
+}
+
+static void accessHook(volatile void *reg)
+{
+    size_t offset = (size_t)((volatile uint8_t *)reg - sfr);
+    sim_time_t time;
+
+    commit();
+    stats.sfrAccesses++;
+    time = now + cycle;
+    if(time < nextEvent) {
+        now = time;
+    } else {
+        processUntil(time);
+    }
+    interrupt();
+
+    if(!watch[offset]) {
+        return;
+    }
+    if(watch[offset] == WATCH_TMR2) {
+        host_sfr.sfr_TMR2 = timerCount();
+    }
+    shadow[offset] = sfr[offset];
+    lastAccess = offset;
+}
+
+static void sleepHook(void)
+{
+    sim_time_t start = now;
+
+    commit();
+    stats.sleeps++;
+    if(requested) {
+        return;
+    }
+
+    // without IDLEN the system clock and TMR2 stop
+    sleeping = true;
+    if(!host_sfr.sfr_CPUDOZE.IDLEN) {
+        timerSync(timerCount());
+        updateNextEvent();
+    }
+    while(!requested) {
+        if(!periodLength && writeDone == NEVER && !actionCount) {
+            // nothing left that could wake the core
+            deadlocked = true;
+            longjmp(stopJump, 1);
+        }
+        processUntil(nextEvent);
+    }
+    sleeping = false;
+    if(!host_sfr.sfr_CPUDOZE.IDLEN) {
+        timerSync(timerCount());
+        updateNextEvent();
+    }
+    stats.sleepTime += now - start;
+}
+
+static void delayHook(unsigned long us)
+{
+    // __delay_us() counts instruction cycles of _XTAL_FREQ = 32 MHz
+    sim_time_t end = now + (sim_time_t)us * 8 * cycle;
+
+    commit();
+    while(now < end) {
+        processUntil(nextEvent < end ? nextEvent : end);
+        interrupt();
+    }
+}
+
+/*
+ * Interface
+ */
+
+void sim_reset(void)
+{
+    for(size_t i = 0; i < sizeof(HostSfrFile_t); i++) {
+        sfr[i] = 0;
+    }
+    host_sfr.sfr_PR2 = 0xFF;
+    host_sfr.sfr_OSCCON1.reg = 0x60;
+    host_sfr.sfr_PORTA.RA5 = 1;     // pull-up, released
+    for(size_t i = 0; i < sizeof(HostSfrFile_t); i++) {
+        shadow[i] = sfr[i];
+    }
+    lastAccess = NO_ACCESS;
+
+    now = 0;
+    stopTime = NEVER;
+    inInterrupt = false;
+    sleeping = false;
+    deadlocked = false;
+    memset(&stats, 0, sizeof(stats));
+    actionCount = 0;
+
+    postscaleCount = 0;
+    latchPending = false;
+    timerSync(0);
+    updateInterrupt();
+
+    memset(activeDuty, 0, sizeof(activeDuty));
+    activePeriod = 4 * 256;
+    memset(onTime, 0, sizeof(onTime));
+    onTimeSince = 0;
+    logCount = 0;
+
+    memset(eeprom, 0xFF, sizeof(eeprom));
+    memcpy(eeprom, eeprom_values, SIM_EEPROM_IMAGE_SIZE);
+    unlockStage = 0;
+    writeDone = NEVER;
+
+    updateNextEvent();
+}
+
+bool sim_run(sim_time_t duration)
+{
+    stopTime = now + duration;
+    updateNextEvent();
+
+    host_sfr_hook = accessHook;
+    host_sleep_hook = sleepHook;
+    host_delay_hook = delayHook;
+    if(!setjmp(stopJump)) {
+        firmware_main();
+    }
+    host_sfr_hook = NULL;
+    host_sleep_hook = NULL;
+    host_delay_hook = NULL;
+
+    integrateOnTime();
+    return !deadlocked;
+}
+
+void sim_stop(void)
+{
+    stopTime = now;
+    nextEvent = now;
+}
+
+sim_time_t sim_now(void)
+{
+    return now;
+}
+
+void sim_at(sim_time_t time, void (*action)(void *arg), void *arg)
+{
+    size_t i;
+
+    if(actionCount == actionCapacity) {
+        size_t capacity = actionCapacity ? actionCapacity * 2 : 16;
+        Action_t *grown = realloc(actions, capacity * sizeof(*actions));
+
+        if(!grown) {
+            abort();
+        }
+        actions = grown;
+        actionCapacity = capacity;
+    }
+    // latest first, equal times run in the order they were added
+    for(i = actionCount; i > 0 && actions[i - 1].time <= time; i--) {
+        actions[i] = actions[i - 1];
+    }
+    actions[i] = (Action_t){ time, action, arg };
+    actionCount++;
+    updateNextEvent();
+}
+
+void sim_button(sim_time_t time, sim_time_t duration)
+{
+    sim_at(time, setButton, NULL);
+    sim_at(time + duration, setButton, (void *)1);
+}
+
+void sim_on_duty(void (*hook)(const SimDutyChange_t *change))
+{
+    dutyHook = hook;
+}
+
+void sim_on_period(void (*hook)(const SimPeriod_t *period))
+{
+    periodHook = hook;
+    updateNextEvent();
+}
+
+void sim_on_button(void (*hook)(sim_time_t time, bool level))
+{
+    buttonHook = hook;
+}
+
+bool sim_button_level(void)
+{
+    return host_sfr.sfr_PORTA.RA5;
+}
+
+const SimDutyChange_t *sim_duty_log(size_t *count)
+{
+    *count = logCount;
+    return dutyLog;
+}
+
+void sim_set_log_limit(size_t limit)
+{
+    logLimit = limit;
+}
+
+uint16_t sim_duty(SimPwm_t pwm)
+{
+    return activeDuty[pwm];
+}
+
+uint16_t sim_duty_period(void)
+{
+    return activePeriod;
+}
+
+double sim_on_time(SimPwm_t pwm)
+{
+    return onTime[pwm] + dutyFraction(activeDuty[pwm], activePeriod) * SIM_TO_SECONDS(now - onTimeSince);
+}
+
+uint8_t *sim_eeprom(void)
+{
+    return eeprom;
+}
+
+const SimStats_t *sim_stats(void)
+{
+    return &stats;
+}
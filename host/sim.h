@@ -0,0 +1,182 @@
+/*
+ * Register level simulation of the PIC16F18313 peripherals the firmware uses
+ *
+ * The firmware runs natively against the register file of xc.h. Its code
+ * takes no time except for one instruction cycle per SFR access; SLEEP and
+ * __delay_xx() advance a virtual clock. The model covers:
+ *
+ *   TMR2    PR2, T2CON pre- and postscaler, TMR2 reads and writes, TMR2IF,
+ *           clocked from HFINTOSC / NDIV, stopped by TMR2MD or by SLEEP
+ *           without IDLEN
+ *   PWM     CCP1/2 (left aligned) and PWM5/6 duties, latched at the period
+ *           match like the hardware double buffer
+ *   NVM     data EEPROM reads, writes with the 55/AA unlock, WREN, the
+ *           write time and NVMIF, gated by NVMMD
+ *   PORTA   RA5 input with pull-up, IOC on both edges
+ *   CPU     interrupts between SFR accesses while GIE is set, SLEEP wakes
+ *           on any enabled interrupt flag
+ *
+ * Every change of a latched duty is recorded for assertions. While a period
+ * hook is set every PWM period is reported, enough to draw the waveforms.
+ */
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// virtual time in HFINTOSC cycles (32 MHz)
+typedef uint64_t sim_time_t;
+
+#define SIM_CLOCK_HZ            32000000ULL
+#define SIM_US(us)              ((sim_time_t)(us) * (SIM_CLOCK_HZ / 1000000ULL))
+#define SIM_MS(ms)              SIM_US((sim_time_t)(ms) * 1000ULL)
+#define SIM_SECONDS(s)          SIM_MS((sim_time_t)(s) * 1000ULL)
+#define SIM_TO_SECONDS(t)       ((double)(t) / SIM_CLOCK_HZ)
+
+// data EEPROM at 0xF000, the firmware image is eeprom_values[] of main.c
+#define SIM_EEPROM_ADDRESS      0xF000
+#define SIM_EEPROM_SIZE         256
+#define SIM_EEPROM_IMAGE_SIZE   64
+
+// data EEPROM byte write time
+#define SIM_EEPROM_WRITE_TIME   SIM_MS(4)
+
+// button press from power-up, long enough to pass the debouncer
+#define SIM_PRESS_TIME          SIM_MS(100)
+
+typedef enum SimPwm {
+    SIM_CCP1 = 0,       // RA0, green
+    SIM_CCP2 = 1,       // RA1, red
+    SIM_PWM5 = 2,       // RA2, blue
+    SIM_PWM6 = 3,       // RA4, white
+    SIM_PWM_COUNT
+} SimPwm_t;
+
+// one latched duty change, duty / period is the on time of the output
+typedef struct SimDutyChange {
+    sim_time_t time;
+    uint8_t pwm;        // SimPwm_t
+    uint16_t duty;      // 10 bit duty, 0 while the module is off
+    uint16_t period;    // 4 * (PR2 + 1)
+} SimDutyChange_t;
+
+// one PWM period from its match, duty counts are Tosc * prescaler long
+typedef struct SimPeriod {
+    sim_time_t start;
+    sim_time_t dutyCount;   // length of one duty count
+    uint16_t period;        // duty counts per period, 4 * (PR2 + 1)
+    uint16_t duty[SIM_PWM_COUNT];
+} SimPeriod_t;
+
+typedef struct SimStats {
+    uint64_t sfrAccesses;
+    uint64_t interrupts;
+    uint64_t sleeps;
+    sim_time_t sleepTime;       // spent in SLEEP
+    uint64_t dutyChanges;
+    uint32_t eepromWrites;
+    uint32_t eepromFaults;      // writes without unlock or WREN, NVM use while gated off
+} SimStats_t;
+
+/**
+ * Power-on reset: registers, virtual clock, actions and the duty log.
+ * The EEPROM is loaded from the firmware image, the rest reads 0xFF.
+ */
+void sim_reset(void);
+
+/**
+ * Run the firmware from reset for a while
+ * @param duration virtual time to run
+ * @return false if the firmware slept with no wake-up source left
+ */
+bool sim_run(sim_time_t duration);
+
+/**
+ * End sim_run() at the current time, for actions and hooks
+ */
+void sim_stop(void);
+
+/**
+ * @return virtual time since reset
+ */
+sim_time_t sim_now(void);
+
+/**
+ * Call a function at a point of virtual time, in hardware context between
+ * two firmware instructions. It may read firmware state and schedule more.
+ */
+void sim_at(sim_time_t time, void (*action)(void *arg), void *arg);
+
+/**
+ * Drive the button (RA5) low for a while
+ * @param time start of the press
+ * @param duration held this long
+ */
+void sim_button(sim_time_t time, sim_time_t duration);
+
+/**
+ * Called on every latched duty change, the record is only valid during the call
+ */
+void sim_on_duty(void (*hook)(const SimDutyChange_t *change));
+
+/**
+ * Called at every period match with the duties latched for the new period,
+ * the record is only valid during the call. Steps the timer period by
+ * period while set, keep it to the span of interest.
+ * @param hook NULL to stop
+ */
+void sim_on_period(void (*hook)(const SimPeriod_t *period));
+
+/**
+ * Called when the button input (RA5) changes
+ */
+void sim_on_button(void (*hook)(sim_time_t time, bool level));
+
+/**
+ * @return button input level, low while pressed
+ */
+bool sim_button_level(void);
+
+/**
+ * Duty changes recorded since reset, at most the log limit
+ * @param count number of records
+ */
+const SimDutyChange_t *sim_duty_log(size_t *count);
+
+/**
+ * Cap the recorded duty log, later changes only reach the hook and the stats
+ * @param limit records kept, 0 records nothing
+ */
+void sim_set_log_limit(size_t limit);
+
+/**
+ * @return latched duty of an output
+ */
+uint16_t sim_duty(SimPwm_t pwm);
+
+/**
+ * @return PWM period in duty counts, 4 * (PR2 + 1)
+ */
+uint16_t sim_duty_period(void);
+
+/**
+ * Integral of duty / period over time, the average brightness of a span is
+ * the difference of two readings divided by its length
+ * @return on time since reset in seconds
+ */
+double sim_on_time(SimPwm_t pwm);
+
+/**
+ * @return data EEPROM contents, writable before sim_run()
+ */
+uint8_t *sim_eeprom(void);
+
+/**
+ * @return counters since reset
+ */
+const SimStats_t *sim_stats(void);
+
+#endif // SIM_H
@@ -0,0 +1,361 @@
+/*
+ * Run the firmware on the simulated device
+ *
+ *     ./sim [-d days] [-t seconds] [-p s] [-D s] [-l s] [-b] [-e file] [-o file]
+ *           [-v file] [-T file] [-n periods] [-w start:end] [-W weather] [-P] [-q]
+ *
+ * Prints the average output of every hour of firmware time with the RTC
+ * time of day, then a summary. Exits non-zero if the firmware slept
+ * without a wake-up source or used the NVM the wrong way.
+ *
+ * The waveform dump and the per-period duty trace cover the window of -w.
+ * A second of waveform is about 4 MB, of undecimated trace about 0.4 MB.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "sim.h"
+#include "vcd.h"
+#include "rtc.h"
+#include "weather.h"
+#include "photoperiod.h"
+
+#define REPORT_PERIOD       SIM_SECONDS(3600)
+#define LONG_PRESS_TIME     SIM_MS(1500)
+#define DOUBLE_PRESS_GAP    SIM_MS(150)
+#define BOOT_HOLD_TIME      SIM_MS(500)
+
+// first byte of the example photoperiod program, the image ships 0xFF (see main.c)
+#define PROGRAM_ENABLE      0x01
+
+static const char *const names[SIM_PWM_COUNT] = { "green", "red", "blue", "white" };
+static const char *const weatherNames[WEATHER_MODE_COUNT] = { "clear", "cloudy", "storm" };
+
+// firmware settings, see main.c
+extern WeatherMode_t weatherMode;
+
+// report columns in colour order
+static const SimPwm_t columns[] = { SIM_CCP2, SIM_CCP1, SIM_PWM5, SIM_PWM6 };
+
+static FILE *csv;
+static bool quiet;
+
+// waveform and period trace window
+static const char *vcdPath;
+static FILE *trace;
+static unsigned long decimation = 1;
+static sim_time_t windowStart;
+static sim_time_t windowEnd = UINT64_MAX;
+static bool windowOpen;
+
+// periods summed for the next trace row, all of the same length
+static unsigned long traceCount;
+static sim_time_t traceStart;
+static uint16_t tracePeriodLength;
+static uint32_t traceSum[SIM_PWM_COUNT];
+static double lastOnTime[SIM_PWM_COUNT];
+static sim_time_t lastReport;
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+            "usage: %s [-d days] [-t seconds] [-p s] [-D s] [-l s] [-b] [-e file] [-o file]\n"
+            "          [-v file] [-T file] [-n periods] [-w start:end] [-W weather] [-P] [-q]\n"
+            "  -d DAYS     run DAYS of firmware time (default 1)\n"
+            "  -t SECONDS  run SECONDS of firmware time\n"
+            "  -p S        short press S seconds after power-up, repeatable\n"
+            "  -D S        double press at S seconds, repeatable\n"
+            "  -l S        long press at S seconds, repeatable\n"
+            "  -b          hold the button at power-up\n"
+            "  -e FILE     data EEPROM, loaded if it exists and saved at the end\n"
+            "  -o FILE     write every duty change as CSV\n"
+            "  -v FILE     write the output and button waveforms as VCD\n"
+            "  -T FILE     write the duties of every PWM period as CSV\n"
+            "  -n N        average N periods per trace row (default 1)\n"
+            "  -w S:E      waveform and trace from S to E seconds (default all)\n"
+            "  -W NAME     weather over the day scene: clear, cloudy or storm\n"
+            "  -P          enable the example photoperiod program of the image\n"
+            "  -q          no hourly report\n", name);
+    exit(EXIT_FAILURE);
+}
+
+static sim_time_t seconds(const char *text)
+{
+    char *end;
+    double value = strtod(text, &end);
+
+    if(*end || value < 0) {
+        fprintf(stderr, "bad time: %s\n", text);
+        exit(EXIT_FAILURE);
+    }
+    return (sim_time_t)(value * SIM_CLOCK_HZ);
+}
+
+static void writeChange(const SimDutyChange_t *change)
+{
+    fprintf(csv, "%.6f,%s,%u,%u\n", SIM_TO_SECONDS(change->time), names[change->pwm],
+            change->duty, change->period);
+}
+
+static void traceRow(void)
+{
+    fprintf(trace, "%.9f,%u", SIM_TO_SECONDS(traceStart), tracePeriodLength);
+    for(size_t i = 0; i < sizeof(columns) / sizeof(columns[0]); i++) {
+        fprintf(trace, ",%.3f", (double)traceSum[columns[i]] / traceCount);
+    }
+    fputc('\n', trace);
+    memset(traceSum, 0, sizeof(traceSum));
+    traceCount = 0;
+}
+
+static void tracePeriod(const SimPeriod_t *period)
+{
+    // duties of different periods do not average, a new period ends the row early
+    if(traceCount && period->period != tracePeriodLength) {
+        traceRow();
+    }
+    if(!traceCount) {
+        traceStart = period->start;
+        tracePeriodLength = period->period;
+    }
+    for(uint8_t i = 0; i < SIM_PWM_COUNT; i++) {
+        traceSum[i] += period->duty[i];
+    }
+    if(++traceCount >= decimation) {
+        traceRow();
+    }
+}
+
+static void windowPeriod(const SimPeriod_t *period)
+{
+    vcd_period(period);
+    if(trace) {
+        tracePeriod(period);
+    }
+}
+
+static void openWindow(void *arg)
+{
+    (void)arg;
+    if(vcdPath && !vcd_open(vcdPath, sim_now(), sim_button_level())) {
+        perror(vcdPath);
+        exit(EXIT_FAILURE);
+    }
+    sim_on_period(windowPeriod);
+    sim_on_button(vcd_button);
+    windowOpen = true;
+}
+
+static void closeWindow(void *arg)
+{
+    (void)arg;
+    if(!windowOpen) {
+        return;
+    }
+    sim_on_period(NULL);
+    sim_on_button(NULL);
+    vcd_close(sim_now());
+    windowOpen = false;
+}
+
+static void parseWindow(const char *text)
+{
+    char *end;
+    double start = strtod(text, &end);
+    double stop;
+
+    if(*end != ':' || start < 0) {
+        fprintf(stderr, "bad window: %s\n", text);
+        exit(EXIT_FAILURE);
+    }
+    stop = strtod(end + 1, &end);
+    if(*end || stop <= start) {
+        fprintf(stderr, "bad window: %s\n", text);
+        exit(EXIT_FAILURE);
+    }
+    windowStart = (sim_time_t)(start * SIM_CLOCK_HZ);
+    windowEnd = (sim_time_t)(stop * SIM_CLOCK_HZ);
+}
+
+static WeatherMode_t parseWeather(const char *text)
+{
+    for(uint8_t i = 0; i < WEATHER_MODE_COUNT; i++) {
+        if(!strcmp(text, weatherNames[i])) {
+            return (WeatherMode_t)i;
+        }
+    }
+    fprintf(stderr, "bad weather: %s\n", text);
+    exit(EXIT_FAILURE);
+}
+
+static void report(void *arg)
+{
+    double span = SIM_TO_SECONDS(sim_now() - lastReport);
+    uint16_t minutes = RTC_GetMinutes();
+
+    (void)arg;
+    printf("%8.0f s  %02u:%02u ", SIM_TO_SECONDS(sim_now()), minutes / 60, minutes % 60);
+    for(size_t i = 0; i < sizeof(columns) / sizeof(columns[0]); i++) {
+        SimPwm_t pwm = columns[i];
+        double onTime = sim_on_time(pwm);
+
+        printf("  %s %6.2f %%", names[pwm], 100.0 * (onTime - lastOnTime[pwm]) / span);
+        lastOnTime[pwm] = onTime;
+    }
+    printf("  eeprom %u\n", sim_stats()->eepromWrites);
+
+    lastReport = sim_now();
+    sim_at(lastReport + REPORT_PERIOD, report, NULL);
+}
+
+// a missing file keeps the firmware image
+static bool loadEeprom(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    size_t read;
+
+    if(!file) {
+        return true;
+    }
+    read = fread(sim_eeprom(), 1, SIM_EEPROM_SIZE, file);
+    fclose(file);
+    return read == SIM_EEPROM_SIZE;
+}
+
+static void saveEeprom(const char *path)
+{
+    FILE *file = fopen(path, "wb");
+
+    if(!file || fwrite(sim_eeprom(), 1, SIM_EEPROM_SIZE, file) != SIM_EEPROM_SIZE) {
+        fprintf(stderr, "cannot write %s\n", path);
+    }
+    if(file) {
+        fclose(file);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    sim_time_t duration = SIM_SECONDS(86400);
+    const char *eepromPath = NULL;
+    const SimStats_t *stats;
+    struct timespec start, end;
+    double wall;
+    bool completed;
+    int option;
+
+    sim_reset();
+
+    while((option = getopt(argc, argv, "d:t:p:D:l:be:o:v:T:n:w:W:Pq")) != -1) {
+        switch(option) {
+            case 'd':
+                duration = seconds(optarg) * 86400;
+                break;
+            case 't':
+                duration = seconds(optarg);
+                break;
+            case 'p':
+                sim_button(seconds(optarg), SIM_PRESS_TIME);
+                break;
+            case 'D':
+                sim_button(seconds(optarg), SIM_PRESS_TIME);
+                sim_button(seconds(optarg) + SIM_PRESS_TIME + DOUBLE_PRESS_GAP, SIM_PRESS_TIME);
+                break;
+            case 'l':
+                sim_button(seconds(optarg), LONG_PRESS_TIME);
+                break;
+            case 'b':
+                sim_button(0, BOOT_HOLD_TIME);
+                break;
+            case 'e':
+                eepromPath = optarg;
+                break;
+            case 'o':
+                csv = fopen(optarg, "w");
+                if(!csv) {
+                    perror(optarg);
+                    return EXIT_FAILURE;
+                }
+                fprintf(csv, "seconds,output,duty,period\n");
+                sim_on_duty(writeChange);
+                break;
+            case 'v':
+                vcdPath = optarg;
+                break;
+            case 'T':
+                trace = fopen(optarg, "w");
+                if(!trace) {
+                    perror(optarg);
+                    return EXIT_FAILURE;
+                }
+                fprintf(trace, "seconds,period,red,green,blue,white\n");
+                break;
+            case 'n':
+                decimation = strtoul(optarg, NULL, 10);
+                if(!decimation) {
+                    usage(argv[0]);
+                }
+                break;
+            case 'w':
+                parseWindow(optarg);
+                break;
+            case 'W':
+                weatherMode = parseWeather(optarg);
+                break;
+            case 'P':
+                sim_eeprom()[PHOTOPERIOD_BASE_ADDRESS - SIM_EEPROM_ADDRESS] = PROGRAM_ENABLE;
+                break;
+            case 'q':
+                quiet = true;
+                break;
+            default:
+                usage(argv[0]);
+        }
+    }
+    if(optind != argc) {
+        usage(argv[0]);
+    }
+
+    if(eepromPath && !loadEeprom(eepromPath)) {
+        fprintf(stderr, "%s is not a %u byte EEPROM image\n", eepromPath, SIM_EEPROM_SIZE);
+        return EXIT_FAILURE;
+    }
+    if(!quiet) {
+        sim_at(REPORT_PERIOD, report, NULL);
+    }
+    if(vcdPath || trace) {
+        sim_at(windowStart, openWindow, NULL);
+        if(windowEnd != UINT64_MAX) {
+            sim_at(windowEnd, closeWindow, NULL);
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    completed = sim_run(duration);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    wall = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+
+    stats = sim_stats();
+    printf("\n%.1f s of firmware time in %.2f s%s\n", SIM_TO_SECONDS(sim_now()), wall,
+           completed ? "" : ", stopped: asleep with nothing to wake it");
+    printf("interrupts %llu, sleeps %llu, asleep %.1f %%, SFR accesses %llu\n",
+           (unsigned long long)stats->interrupts, (unsigned long long)stats->sleeps,
+           100.0 * stats->sleepTime / (sim_now() ? sim_now() : 1), (unsigned long long)stats->sfrAccesses);
+    printf("duty changes %llu, EEPROM writes %u, NVM faults %u\n",
+           (unsigned long long)stats->dutyChanges, stats->eepromWrites, stats->eepromFaults);
+
+    if(eepromPath) {
+        saveEeprom(eepromPath);
+    }
+    if(csv) {
+        fclose(csv);
+    }
+    closeWindow(NULL);
+    if(trace) {
+        fclose(trace);
+    }
+    return (completed && !stats->eepromFaults) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,77 @@
+/*
+ * HSV colour engine against a floating point reference
+ *
+ *     ./test_colour
+ *
+ * Every saturation and brightness on 262 hues spread over all six sectors
+ * and on the named ones: every level within one of the exact colour, a
+ * grey on white alone and a saturated colour with white off.
+ */
+
+#include "check.h"
+#include "colour.h"
+#include "colour_ref.h"
+
+#define HUE_STEP        251
+#define ERROR_MAX       1.0
+
+static const uint16_t named[] = {
+    COLOUR_HUE_RED, COLOUR_HUE_YELLOW, COLOUR_HUE_GREEN,
+    COLOUR_HUE_CYAN, COLOUR_HUE_BLUE, COLOUR_HUE_MAGENTA
+};
+
+// worst level of a colour and where it was
+static double maxError;
+static uint16_t worstHue;
+static uint8_t worstSaturation, worstValue;
+
+static void colour(uint16_t hue, uint8_t saturation, uint8_t value)
+{
+    uint16_t levels[OUTPUT_CHANNEL_COUNT];
+    double exact[OUTPUT_CHANNEL_COUNT];
+
+    COLOUR_HsvToLevels(hue, saturation, value, levels);
+    colour_reference(hue, saturation, value, exact);
+    for(uint8_t i = 0; i < OUTPUT_CHANNEL_COUNT; i++) {
+        double error = fabs(levels[i] - exact[i]);
+
+        if(error > maxError) {
+            maxError = error;
+            worstHue = hue;
+            worstSaturation = saturation;
+            worstValue = value;
+        }
+    }
+
+    if(saturation == 0) {
+        CHECK(levels[OUTPUT_RED] == 0 && levels[OUTPUT_GREEN] == 0 && levels[OUTPUT_BLUE] == 0 &&
+              levels[OUTPUT_WHITE] == GAMMA_LEVEL(value),
+              "grey of brightness %u at hue 0x%04X is not white alone", value, hue);
+    } else if(saturation == 255) {
+        CHECK(levels[OUTPUT_WHITE] == 0, "pure colour at hue 0x%04X brightness %u lights white", hue, value);
+    }
+}
+
+// every saturation and brightness of a hue
+static void hue(uint16_t h)
+{
+    for(uint16_t saturation = 0; saturation < 256; saturation++) {
+        for(uint16_t value = 0; value < 256; value++) {
+            colour(h, (uint8_t)saturation, (uint8_t)value);
+        }
+    }
+}
+
+int main(void)
+{
+    for(uint32_t h = 0; h < 0x10000; h += HUE_STEP) {
+        hue((uint16_t)h);
+    }
+    for(uint8_t i = 0; i < sizeof(named) / sizeof(named[0]); i++) {
+        hue(named[i]);
+    }
+    CHECK(maxError <= ERROR_MAX, "%.2f levels off at hue 0x%04X saturation %u brightness %u",
+          maxError, worstHue, worstSaturation, worstValue);
+
+    return check_exit("test_colour");
+}
@@ -0,0 +1,139 @@
+/*
+ * Demo effects of main.c on the host register file
+ *
+ *     ./test_demo
+ *
+ * The main loop runs the panel presets, the effects are only reached
+ * through loop_for_demo(); here it runs in its place, one call and one
+ * FADE_Task() per tick. Checks that the random effect crossfades to a new
+ * colour every randomInterval ticks in randomFadeTicks, one channel or all
+ * of them at a logical brightness it may pick, and comes to every one of
+ * them, and that the colour wheel sets the colour of its hue at once on
+ * every tick, within a level of the floating point reference, a full turn
+ * round.
+ */
+
+#include "check.h"
+#include "mcc_generated_files/mcc.h"
+#include "output.h"
+#include "fade.h"
+#include "gamma.h"
+#include "colour.h"
+#include "demo.h"
+#include "colour_ref.h"
+
+#define RANDOM_COLOURS          500
+
+// firmware settings, see main.c
+extern uint8_t state;
+extern uint16_t randomInterval;
+extern uint16_t randomFadeTicks;
+
+// one tick of the main loop with the demo in place of the panel
+static void tick(void)
+{
+    loop_for_demo();
+    FADE_Task();
+}
+
+// logical brightness of a level, RANDOM_BRIGHTNESS_COUNT if the random effect cannot pick it
+static uint8_t brightnessOf(uint16_t level)
+{
+    uint8_t b = 0;
+
+    while(b < RANDOM_BRIGHTNESS_COUNT && GAMMA_Level(b) != level) {
+        b++;
+    }
+    return b;
+}
+
+static void randomColours(void)
+{
+    // one channel or all of them, as OUTPUT_CHANNEL_COUNT
+    bool seenChannel[OUTPUT_CHANNEL_COUNT + 1] = { false };
+    bool seenBrightness[RANDOM_BRIGHTNESS_COUNT] = { false };
+
+    state = 0;
+    tick();
+    CHECK(state == DEMO_STATE_RANDOM, "state %u after the first demo tick", state);
+    for(uint8_t i = 0; i < OUTPUT_CHANNEL_COUNT; i++) {
+        CHECK(OUTPUT_GetChannel((OutputChannel_t)i) == 0, "channel %u not switched off", i);
+    }
+
+    for(unsigned c = 0; c < RANDOM_COLOURS; c++) {
+        uint16_t level = 0;
+        uint8_t lit = 0;
+        uint8_t channel = 0;
+        uint8_t b;
+
+        // a new crossfade on the first tick, none after it until the next colour
+        for(uint16_t t = 0; t < randomInterval; t++) {
+            loop_for_demo();
+            CHECK(FADE_IsActive() == (t < randomFadeTicks), "colour %u: fade %s at tick %u",
+                  c, FADE_IsActive() ? "running" : "ended", t);
+            FADE_Task();
+        }
+
+        for(uint8_t i = 0; i < OUTPUT_CHANNEL_COUNT; i++) {
+            uint16_t l = OUTPUT_GetChannel((OutputChannel_t)i);
+
+            if(l != 0) {
+                CHECK(lit == 0 || l == level, "colour %u: channels at %u and %u", c, level, l);
+                level = l;
+                channel = i;
+                lit++;
+            }
+        }
+        b = brightnessOf(level);
+        CHECK(b < RANDOM_BRIGHTNESS_COUNT, "colour %u: level %u of no brightness below %u",
+              c, level, RANDOM_BRIGHTNESS_COUNT);
+        CHECK(lit == 0 || lit == 1 || lit == OUTPUT_CHANNEL_COUNT, "colour %u: %u channels lit", c, lit);
+        if(b < RANDOM_BRIGHTNESS_COUNT) {
+            seenBrightness[b] = true;
+        }
+        if(lit != 0) {
+            seenChannel[lit == 1 ? channel : OUTPUT_CHANNEL_COUNT] = true;
+        }
+    }
+
+    for(uint8_t i = 0; i < OUTPUT_CHANNEL_COUNT; i++) {
+        CHECK(seenChannel[i], "no random colour on channel %u alone", i);
+    }
+    CHECK(seenChannel[OUTPUT_CHANNEL_COUNT], "no random colour on all channels");
+    for(uint8_t b = 0; b < RANDOM_BRIGHTNESS_COUNT; b++) {
+        CHECK(seenBrightness[b], "no random colour at brightness %u", b);
+    }
+}
+
+static void colourWheel(void)
+{
+    double exact[OUTPUT_CHANNEL_COUNT];
+    uint16_t hue = COLOUR_HUE_RED;
+    // a turn and back to red
+    uint32_t ticks = 0x10000UL / RAINBOW_HUE_STEP + 2;
+
+    state = DEMO_STATE_RAINBOW;
+    for(uint32_t t = 0; t < ticks; t++) {
+        tick();
+        CHECK(!FADE_IsActive(), "colour wheel: fade running at hue 0x%04X", hue);
+        colour_reference(hue, RAINBOW_SATURATION, RAINBOW_BRIGHTNESS, exact);
+        for(uint8_t i = 0; i < OUTPUT_CHANNEL_COUNT; i++) {
+            CHECK(fabs(OUTPUT_GetChannel((OutputChannel_t)i) - exact[i]) <= 1.0,
+                  "colour wheel: channel %u at %u, %.1f exact at hue 0x%04X",
+                  i, OUTPUT_GetChannel((OutputChannel_t)i), exact[i], hue);
+        }
+        hue += RAINBOW_HUE_STEP;
+    }
+    CHECK(state == DEMO_STATE_RAINBOW, "colour wheel: left for state %u", state);
+}
+
+int main(void)
+{
+    TMR2_Initialize();
+    OUTPUT_Initialize();
+    FADE_Initialize();
+
+    randomColours();
+    colourWheel();
+    return check_exit("test_demo");
+}
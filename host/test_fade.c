@@ -0,0 +1,99 @@
+/*
+ * Crossfade engine on the host register file
+ *
+ *     ./test_fade
+ *
+ * Runs random fades through FADE_Task() tick by tick and checks every
+ * trajectory: it takes exactly the requested ticks, never moves a channel
+ * against its direction, never steps more than a level past the even
+ * share of its distance and ends exactly on the target.
+ */
+
+#include "check.h"
+#include "mcc_generated_files/mcc.h"
+#include "output.h"
+#include "fade.h"
+
+#define FADE_COUNT      2000
+
+// a few long fades, the rest short enough to keep the run quick
+static uint16_t randomTicks(void)
+{
+    switch(rand() & 7) {
+        case 0:
+            return (uint16_t)(1 + rand() % UINT16_MAX);
+        case 1:
+            return (uint16_t)(1 + (rand() & 3));
+        default:
+            return (uint16_t)(1 + rand() % 2000);
+    }
+}
+
+// random levels, some of them duty aligned or at the ends of the range
+static uint16_t randomLevel(void)
+{
+    switch(rand() & 3) {
+        case 0:
+            return (rand() & 1) ? 0 : OUTPUT_LEVEL_MAX;
+        case 1:
+            return OUTPUT_LEVEL_FROM_DUTY8(rand() & 0xFF);
+        default:
+            return (uint16_t)rand();
+    }
+}
+
+static void fade(uint16_t ticks)
+{
+    uint16_t start[OUTPUT_CHANNEL_COUNT];
+    uint16_t target[OUTPUT_CHANNEL_COUNT];
+    uint16_t previous[OUTPUT_CHANNEL_COUNT];
+    int maxStep[OUTPUT_CHANNEL_COUNT];
+    uint32_t taken = 0;
+
+    for(uint8_t i = 0; i < OUTPUT_CHANNEL_COUNT; i++) {
+        start[i] = randomLevel();
+        target[i] = randomLevel();
+        previous[i] = start[i];
+        maxStep[i] = (abs((int)target[i] - (int)start[i]) + ticks - 1) / ticks + 1;
+    }
+    OUTPUT_SetRGBW(start[0], start[1], start[2], start[3]);
+    FADE_To(target[0], target[1], target[2], target[3], ticks);
+
+    while(FADE_IsActive() && taken <= ticks) {
+        FADE_Task();
+        taken++;
+        for(uint8_t i = 0; i < OUTPUT_CHANNEL_COUNT; i++) {
+            uint16_t level = OUTPUT_GetChannel((OutputChannel_t)i);
+            bool up = target[i] >= start[i];
+
+            CHECK(up ? level >= previous[i] && level <= target[i] : level <= previous[i] && level >= target[i],
+                  "%u -> %u in %u ticks: channel %u went from %u to %u at tick %u",
+                  start[i], target[i], ticks, i, previous[i], level, taken);
+            CHECK(abs((int)level - (int)previous[i]) <= maxStep[i],
+                  "%u -> %u in %u ticks: channel %u stepped %u to %u at tick %u",
+                  start[i], target[i], ticks, i, previous[i], level, taken);
+            previous[i] = level;
+        }
+    }
+
+    CHECK(taken == ticks, "%u tick fade took %u", ticks, taken);
+    for(uint8_t i = 0; i < OUTPUT_CHANNEL_COUNT; i++) {
+        CHECK(previous[i] == target[i], "%u -> %u in %u ticks ended on %u",
+              start[i], target[i], ticks, previous[i]);
+    }
+}
+
+int main(void)
+{
+    TMR2_Initialize();
+    OUTPUT_Initialize();
+    FADE_Initialize();
+    srand(1);
+
+    fade(1);
+    fade(UINT16_MAX);
+    for(uint16_t i = 0; i < FADE_COUNT; i++) {
+        fade(randomTicks());
+    }
+    return check_exit("test_fade");
+}
@@ -0,0 +1,49 @@
+/*
+ * Perceptual brightness curve
+ *
+ *     ./test_gamma
+ *
+ * Compares GAMMA_Level() with the CIE 1931 lightness curve at every
+ * brightness: exact end points and knots, a strict rise on every step
+ * and the interpolated levels within a few levels of the curve.
+ */
+
+#include <math.h>
+#include "check.h"
+#include "output.h"
+#include "gamma.h"
+
+// the segments lie above the convex curve, by 9 levels at most
+#define ABOVE_MAX       9
+#define BELOW_MAX       1
+
+static double cie(unsigned brightness)
+{
+    double lightness = 100.0 * brightness / 255;
+
+    if(lightness <= 8.0) {
+        return lightness / 903.3 * OUTPUT_LEVEL_MAX;
+    }
+    return pow((lightness + 16.0) / 116.0, 3.0) * OUTPUT_LEVEL_MAX;
+}
+
+int main(void)
+{
+    CHECK(GAMMA_LEVEL(0) == 0 && GAMMA_LEVEL(255) == OUTPUT_LEVEL_MAX,
+          "end points %u..%u", GAMMA_LEVEL(0), GAMMA_LEVEL(255));
+
+    for(unsigned b = 0; b <= 255; b++) {
+        long exact = lround(cie(b));
+        long error = (long)GAMMA_LEVEL(b) - exact;
+
+        if(b) {
+            CHECK(GAMMA_LEVEL(b) > GAMMA_LEVEL(b - 1), "not rising at %u", b);
+        }
+        if(b % 4 == 0 || b == 255) {
+            CHECK(error == 0, "knot %u at %u, the curve at %ld", b, GAMMA_LEVEL(b), exact);
+        }
+        CHECK(error <= ABOVE_MAX && error >= -BELOW_MAX, "brightness %u at %u, the curve at %ld",
+              b, GAMMA_LEVEL(b), exact);
+    }
+    return check_exit("test_gamma");
+}
@@ -0,0 +1,178 @@
+/*
+ * Output stage on the host register file
+ *
+ *     ./test_output
+ *
+ * Drives output.c and its period ISR directly. The timer does not run,
+ * every OUTPUT_PeriodISR() call stands for one period interrupt.
+ *
+ * Checks that full scale never wraps, that the dithered average of every
+ * level is within one dither step below the exact duty, and that a clock
+ * switch stages PR2, T2CON and NDIV to the next period interrupt and keeps
+ * the duty ratio of every channel.
+ */
+
+#include <math.h>
+#include "check.h"
+#include "mcc_generated_files/mcc.h"
+#include "output.h"
+#include "profile.h"
+
+static const char *const profileNames[PROFILE_COUNT] = {
+    "standard", "high frequency", "max resolution", "low frequency"
+};
+
+// duty the red channel (PWM2, left aligned) runs with
+static uint16_t redDuty(void)
+{
+    return (uint16_t)((CCPR2H << 2) | (CCPR2L >> 6));
+}
+
+// duty the white channel (PWM6) runs with
+static uint16_t whiteDuty(void)
+{
+    return (uint16_t)((PWM6DCH << 2) | (PWM6DCL >> 6));
+}
+
+// every channel off in a profile, its timing latched
+static void setup(PwmProfile_t profile, bool slow)
+{
+    TMR2_Initialize();
+    PWM1_Initialize();
+    PWM2_Initialize();
+    PWM5_Initialize();
+    PWM6_Initialize();
+    OUTPUT_Initialize();
+    PROFILE_Initialize();
+    PROFILE_Select(profile);
+    PROFILE_SetSlow(slow);
+    OUTPUT_Commit();
+    OUTPUT_PeriodISR();
+    // the switch ends the period, nothing runs the timer here
+    TMR2 = 0;
+}
+
+// full scale loads the top code or above on every period, the dither carry never wraps
+static void fullScale(void)
+{
+    for(uint8_t profile = 0; profile < PROFILE_COUNT; profile++) {
+        for(uint8_t slow = 0; slow < 2; slow++) {
+            uint16_t top;
+
+            setup((PwmProfile_t)profile, slow);
+            top = ((uint16_t)PR2 << 2) | 3;
+            OUTPUT_SetChannel(OUTPUT_RED, OUTPUT_LEVEL_MAX);
+            OUTPUT_Commit();
+            for(uint8_t i = 0; i < 64; i++) {
+                OUTPUT_PeriodISR();
+                CHECK(redDuty() >= top, "%s%s: full scale loaded %u, top code %u",
+                      profileNames[profile], slow ? " slow" : "", redDuty(), top);
+            }
+        }
+    }
+}
+
+// duty fraction of the current period
+static double ratio(uint16_t duty)
+{
+    return duty / (4.0 * ((uint16_t)PR2 + 1));
+}
+
+// average duty fraction of a full dither pattern
+static double averageRatio(uint16_t (*duty)(void))
+{
+    double sum = 0;
+
+    for(uint8_t i = 0; i < (1 << OUTPUT_DITHER_BITS); i++) {
+        OUTPUT_PeriodISR();
+        sum += ratio(duty());
+    }
+    return sum / (1 << OUTPUT_DITHER_BITS);
+}
+
+// the dithered average is the exact duty truncated to a dither step, the deep dim levels densely
+static void ditherAccuracy(void)
+{
+    for(uint8_t profile = 0; profile < PROFILE_COUNT; profile++) {
+        for(uint8_t slow = 0; slow < 2; slow++) {
+            double step;
+
+            setup((PwmProfile_t)profile, slow);
+            step = ratio(1) / (1 << OUTPUT_DITHER_BITS);
+            for(uint32_t level = 0; level <= OUTPUT_LEVEL_MAX; level += level < 0x800 ? 1 : 0x3D) {
+                double exact = level / 65536.0;
+                double average;
+
+                OUTPUT_SetChannel(OUTPUT_RED, (uint16_t)level);
+                OUTPUT_Commit();
+                average = averageRatio(redDuty);
+                // the top 10 bit code without a fraction is as far as the duty goes
+                if(exact > ratio(0x3FF)) {
+                    exact = ratio(0x3FF);
+                }
+                CHECK(average <= exact + 1e-9 && average > exact - step - 1e-9,
+                      "%s%s: level 0x%04X averages %.6f, exact %.6f",
+                      profileNames[profile], slow ? " slow" : "", (unsigned)level, average, exact);
+            }
+        }
+    }
+}
+
+// switch the clock of a profile with a colour on, the timing changes at the next interrupt
+static void switchClock(PwmProfile_t profile, bool slow)
+{
+    uint8_t period = PR2;
+    uint8_t timerControl = T2CON;
+    uint8_t clockDivider = OSCCON1 & 0x0F;
+    double red = averageRatio(redDuty);
+    double white = averageRatio(whiteDuty);
+    const char *what = slow ? "slow" : "fast";
+    double step;
+
+    PROFILE_SetSlow(slow);
+    CHECK(PR2 == period && T2CON == timerControl && (OSCCON1 & 0x0F) == clockDivider,
+          "%s %s: timing changed before the commit", profileNames[profile], what);
+    OUTPUT_Commit();
+    CHECK(PR2 == period, "%s %s: PR2 changed on the commit", profileNames[profile], what);
+
+    OUTPUT_PeriodISR();
+    CHECK((OSCCON1 & 0x0F) == (slow ? 1 : 0), "%s %s: NDIV %u",
+          profileNames[profile], what, OSCCON1 & 0x0F);
+    CHECK(PR2 != period && TMR2 == PR2, "%s %s: PR2 0x%02X TMR2 0x%02X, the running period did not end",
+          profileNames[profile], what, PR2, TMR2);
+    // the first duties of the new period already fit it
+    step = ratio(1);
+    CHECK(fabs(ratio(redDuty()) - red) <= step && fabs(ratio(whiteDuty()) - white) <= step,
+          "%s %s: the first period loaded %.4f and %.4f, expected %.4f and %.4f",
+          profileNames[profile], what, ratio(redDuty()), ratio(whiteDuty()), red, white);
+
+    TMR2 = 0;
+    step /= 1 << OUTPUT_DITHER_BITS;
+    CHECK(fabs(averageRatio(redDuty) - red) <= step && fabs(averageRatio(whiteDuty) - white) <= step,
+          "%s %s: duty ratios moved from %.6f and %.6f", profileNames[profile], what, red, white);
+}
+
+static void clockSwitch(void)
+{
+    for(uint8_t profile = 0; profile < PROFILE_COUNT; profile++) {
+        setup((PwmProfile_t)profile, false);
+        if(!PROFILE_SetSlow(true)) {
+            CHECK(!PROFILE_IsSlow(), "%s: slow without a slow period", profileNames[profile]);
+            continue;
+        }
+        setup((PwmProfile_t)profile, false);
+        OUTPUT_SetChannel(OUTPUT_RED, 0x0123);
+        OUTPUT_SetChannel(OUTPUT_WHITE, 0xB7A5);
+        OUTPUT_Commit();
+        switchClock((PwmProfile_t)profile, true);
+        switchClock((PwmProfile_t)profile, false);
+    }
+}
+
+int main(void)
+{
+    fullScale();
+    ditherAccuracy();
+    clockSwitch();
+    return check_exit("test_output");
+}
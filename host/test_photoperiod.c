@@ -0,0 +1,275 @@
+/*
+ * Software RTC and photoperiod program on the host register file
+ *
+ *     ./test_photoperiod
+ *
+ * The EEPROM reads are served from a test image, starting with the one
+ * main.c ships. Checks that the RTC calls the minute handler once per
+ * minute, that the example program fires every event on its minute with
+ * its ramp, day after day, that resuming at any time applies the event
+ * in effect as a plain crossfade, that a disabled, unordered or too
+ * long list loads as the program says, and that the EEPROM is left to a
+ * journal record being written.
+ */
+
+#include <string.h>
+#include "check.h"
+#include "mcc_generated_files/mcc.h"
+#include "photoperiod.h"
+#include "journal.h"
+#include "rtc.h"
+
+#define EEPROM_ADDRESS  0xF000
+#define EEPROM_SIZE     256
+#define PROGRAM         (PHOTOPERIOD_BASE_ADDRESS - EEPROM_ADDRESS)
+#define PROGRAM_ENABLE  0x01
+#define MAX_FIRED       (2 * PHOTOPERIOD_MAX_EVENTS)
+
+// the image main.c ships
+extern unsigned char eeprom_values[64];
+
+static uint8_t eeprom[EEPROM_SIZE];
+
+// the example program, see main.c
+static const struct {
+    uint16_t minutes;
+    uint8_t level;
+    uint8_t rampMinutes;
+} example[] = {
+    { 7 * 60 + 30,  4,                          30 },
+    { 10 * 60,      7,                          30 },
+    { 13 * 60,      3,                          12 },
+    { 15 * 60,      7,                          12 },
+    { 20 * 60,      PHOTOPERIOD_LEVEL_MOONLIGHT, 60 },
+    { 23 * 60,      PHOTOPERIOD_LEVEL_OFF,       30 },
+};
+#define EXAMPLE_COUNT   (sizeof(example) / sizeof(example[0]))
+
+// events passed to the handler since the last clear
+static struct {
+    uint8_t level;
+    uint8_t rampMinutes;
+} fired[MAX_FIRED];
+static unsigned firedCount;
+static uint16_t lastMinute;
+static unsigned minuteCount;
+
+// a read of NVMDATL returns the addressed EEPROM byte, never while a record is written
+static void nvmRead(volatile void *sfr)
+{
+    if(sfr == &host_sfr.sfr_NVMDATL && host_sfr.sfr_NVMCON1.RD) {
+        CHECK(!JOURNAL_IsWriting(), "EEPROM read at 0x%02X during a journal write", host_sfr.sfr_NVMADRL);
+        CHECK(!host_sfr.sfr_PMD0.NVMMD, "EEPROM read at 0x%02X with the NVM off", host_sfr.sfr_NVMADRL);
+        host_sfr.sfr_NVMDATL = eeprom[host_sfr.sfr_NVMADRL];
+        host_sfr.sfr_NVMCON1.RD = 0;
+    }
+}
+
+static void event(uint8_t level, uint8_t rampMinutes)
+{
+    if(firedCount < MAX_FIRED) {
+        fired[firedCount].level = level;
+        fired[firedCount].rampMinutes = rampMinutes;
+    }
+    firedCount++;
+}
+
+static void minute(uint16_t minutes)
+{
+    CHECK(minutes == (lastMinute + 1) % RTC_MINUTES_PER_DAY, "minute %u after %u", minutes, lastMinute);
+    lastMinute = minutes;
+    minuteCount++;
+}
+
+// a day of RTC_Task() calls on the standard tick
+static void rtcDay(void)
+{
+    uint32_t tasks = (uint32_t)RTC_MINUTES_PER_DAY * 60000 / (SCHEDULER_TICK_MS * RTC_TASK_TICKS);
+
+    RTC_Initialize();
+    RTC_SetMinuteHandler(minute);
+    lastMinute = RTC_BOOT_MINUTES;
+    minuteCount = 0;
+    for(uint32_t i = 0; i < tasks; i++) {
+        RTC_Task();
+    }
+    CHECK(minuteCount == RTC_MINUTES_PER_DAY, "%u minutes in a day", minuteCount);
+    CHECK(RTC_GetMinutes() == RTC_BOOT_MINUTES && RTC_GetDays() == 1,
+          "a day after power-up at %u, day %u", RTC_GetMinutes(), RTC_GetDays());
+}
+
+static bool load(void)
+{
+    bool loaded;
+
+    firedCount = 0;
+    PHOTOPERIOD_SetEventHandler(event);
+    loaded = PHOTOPERIOD_Initialize();
+    CHECK(PMD0bits.NVMMD, "the NVM is left clocked");
+    return loaded;
+}
+
+// the image ships the program disabled, nothing fires all day
+static void shippedDisabled(void)
+{
+    memcpy(eeprom, eeprom_values, sizeof(eeprom_values));
+    CHECK(!load(), "the shipped program is enabled");
+    PHOTOPERIOD_Resume(RTC_BOOT_MINUTES);
+    for(uint16_t m = 0; m < RTC_MINUTES_PER_DAY; m++) {
+        PHOTOPERIOD_MinuteHandler(m);
+    }
+    CHECK(firedCount == 0, "%u events fired from a disabled program", firedCount);
+}
+
+// index of the example event in effect at a time of day
+static uint8_t inEffect(uint16_t minutes)
+{
+    uint8_t current = EXAMPLE_COUNT - 1;
+
+    for(uint8_t i = 0; i < EXAMPLE_COUNT; i++) {
+        if(example[i].minutes <= minutes) {
+            current = i;
+        }
+    }
+    return current;
+}
+
+// enabled, every event fires on its minute with its ramp, two days running
+static void exampleDays(void)
+{
+    unsigned expected = 0;
+
+    memcpy(eeprom, eeprom_values, sizeof(eeprom_values));
+    eeprom[PROGRAM] = PROGRAM_ENABLE;
+    CHECK(load(), "the enabled example is empty");
+    PHOTOPERIOD_Resume(RTC_BOOT_MINUTES);
+    firedCount = 0;
+
+    for(unsigned i = 1; i <= 2 * RTC_MINUTES_PER_DAY; i++) {
+        uint16_t m = (RTC_BOOT_MINUTES + i) % RTC_MINUTES_PER_DAY;
+        uint8_t current = inEffect(m);
+
+        PHOTOPERIOD_MinuteHandler(m);
+        if(example[current].minutes != m) {
+            CHECK(firedCount == expected, "an event fired at minute %u", m);
+        } else if(firedCount != expected + 1) {
+            CHECK(false, "%u events at minute %u, expected one", firedCount - expected, m);
+        } else {
+            CHECK(fired[expected].level == example[current].level &&
+                  fired[expected].rampMinutes == example[current].rampMinutes,
+                  "minute %u fired level %u ramp %u, expected %u and %u", m,
+                  fired[expected].level, fired[expected].rampMinutes,
+                  example[current].level, example[current].rampMinutes);
+        }
+        expected = firedCount;
+    }
+    CHECK(firedCount == 2 * EXAMPLE_COUNT, "%u events in two days", firedCount);
+}
+
+// resuming applies the event in effect without its ramp and waits for the next one
+static void resume(void)
+{
+    memcpy(eeprom, eeprom_values, sizeof(eeprom_values));
+    eeprom[PROGRAM] = PROGRAM_ENABLE;
+    load();
+
+    for(uint16_t m = 0; m < RTC_MINUTES_PER_DAY; m += 7) {
+        uint8_t current = inEffect(m);
+        uint8_t next = (uint8_t)((current + 1) % EXAMPLE_COUNT);
+
+        firedCount = 0;
+        PHOTOPERIOD_Resume(m);
+        CHECK(firedCount == 1 && fired[0].level == example[current].level && fired[0].rampMinutes == 0,
+              "resumed at %u: %u events, level %u ramp %u", m, firedCount, fired[0].level, fired[0].rampMinutes);
+
+        // nothing until the next event, which fires
+        for(uint16_t t = (m + 1) % RTC_MINUTES_PER_DAY; t != example[next].minutes;
+                t = (t + 1) % RTC_MINUTES_PER_DAY) {
+            PHOTOPERIOD_MinuteHandler(t);
+        }
+        CHECK(firedCount == 1, "resumed at %u: an event fired before %u", m, example[next].minutes);
+        PHOTOPERIOD_MinuteHandler(example[next].minutes);
+        CHECK(firedCount == 2 && fired[1].level == example[next].level,
+              "resumed at %u: the event at %u did not fire", m, example[next].minutes);
+    }
+}
+
+// a time out of order ends the list, as does the last event that fits
+static void listEnd(void)
+{
+    memset(eeprom, 0xFF, sizeof(eeprom));
+    for(uint8_t i = 0; i <= PHOTOPERIOD_MAX_EVENTS; i++) {
+        uint16_t minutes = (uint16_t)(60 + i * 60);
+        uint8_t *entry = &eeprom[PROGRAM + i * PHOTOPERIOD_EVENT_SIZE];
+
+        entry[0] = (uint8_t)(minutes >> 8);
+        entry[1] = (uint8_t)minutes;
+        entry[2] = PHOTOPERIOD_ACTION(1 + i % 7, 0);
+    }
+    CHECK(load(), "a full list is empty");
+    firedCount = 0;
+    for(uint16_t m = 0; m < RTC_MINUTES_PER_DAY; m++) {
+        PHOTOPERIOD_MinuteHandler(m);
+    }
+    CHECK(firedCount == PHOTOPERIOD_MAX_EVENTS, "%u events from a list longer than %u",
+          firedCount, PHOTOPERIOD_MAX_EVENTS);
+
+    // the third event goes back in time
+    eeprom[PROGRAM + 2 * PHOTOPERIOD_EVENT_SIZE + 1] = 0;
+    load();
+    for(uint16_t m = 0; m < RTC_MINUTES_PER_DAY; m++) {
+        PHOTOPERIOD_MinuteHandler(m);
+    }
+    CHECK(firedCount == 2, "%u events from a list out of order after the second", firedCount);
+}
+
+// the event after one fired while a record was written is read a minute later
+static void journalWriting(void)
+{
+    JournalRecord_t record = { 3, 0 };
+
+    memcpy(eeprom, eeprom_values, sizeof(eeprom_values));
+    eeprom[PROGRAM] = PROGRAM_ENABLE;
+    load();
+    PHOTOPERIOD_Resume(9 * 60);
+
+    // the journal scans at power-up, with the NVM clocked
+    PMD0bits.NVMMD = 0;
+    JOURNAL_Initialize();
+    JOURNAL_Save(&record);
+    for(uint16_t i = 0; i <= JOURNAL_IDLE_TICKS; i++) {
+        JOURNAL_Task();
+    }
+    CHECK(JOURNAL_IsWriting(), "no journal record is being written");
+
+    firedCount = 0;
+    PHOTOPERIOD_MinuteHandler(example[1].minutes);
+    CHECK(firedCount == 1 && fired[0].level == example[1].level,
+          "the event at %u did not fire during a journal write", example[1].minutes);
+
+    // one NVM interrupt per byte of the record
+    for(uint8_t i = 0; i < JOURNAL_RECORD_SIZE; i++) {
+        NVM_ISR();
+    }
+    CHECK(!JOURNAL_IsWriting() && PMD0bits.NVMMD, "the journal write did not complete");
+
+    for(uint16_t m = example[1].minutes + 1; m <= example[2].minutes; m++) {
+        PHOTOPERIOD_MinuteHandler(m);
+    }
+    CHECK(firedCount == 2 && fired[1].level == example[2].level,
+          "the event at %u did not fire after a journal write", example[2].minutes);
+    CHECK(PMD0bits.NVMMD, "the NVM is left clocked");
+}
+
+int main(void)
+{
+    host_sfr_hook = nvmRead;
+
+    rtcDay();
+    shippedDisabled();
+    exampleDays();
+    resume();
+    listEnd();
+    journalWriting();
+    return check_exit("test_photoperiod");
+}
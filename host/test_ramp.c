@@ -0,0 +1,110 @@
+/*
+ * Sunrise / sunset ramp on the host register file
+ *
+ *     ./test_ramp
+ *
+ * Fast-forwards 60 minute ramps through RAMP_Task() step by step, a full
+ * sunrise, a full sunset, one turned around halfway and a few partial
+ * ones, and checks every trajectory: exactly the requested steps, every
+ * channel moving only towards its target, within the truncation of the
+ * increments of the straight line and exactly on the target at the end.
+ */
+
+#include <math.h>
+#include "check.h"
+#include "mcc_generated_files/mcc.h"
+#include "output.h"
+#include "fade.h"
+#include "ramp.h"
+
+#define RAMP_MINUTES    60
+
+static const uint16_t off[OUTPUT_CHANNEL_COUNT] = { 0, 0, 0, 0 };
+static const uint16_t full[OUTPUT_CHANNEL_COUNT] = {
+    OUTPUT_LEVEL_MAX, OUTPUT_LEVEL_MAX, OUTPUT_LEVEL_MAX, OUTPUT_LEVEL_MAX
+};
+static const uint16_t mixed[OUTPUT_CHANNEL_COUNT] = { 0x0040, 0x1234, 0x8000, 0xFFC0 };
+
+// ramp from the current levels, to the end or stopped after some steps
+static void ramp(const uint16_t *target, uint32_t steps, uint32_t stopAfter, const char *what)
+{
+    uint16_t start[OUTPUT_CHANNEL_COUNT];
+    uint16_t previous[OUTPUT_CHANNEL_COUNT];
+    // truncated increments fall behind the line by up to steps / 0x10000 levels
+    double lag = steps / 65536.0 + 1;
+    uint32_t taken = 0;
+
+    for(uint8_t i = 0; i < OUTPUT_CHANNEL_COUNT; i++) {
+        start[i] = previous[i] = OUTPUT_GetChannel((OutputChannel_t)i);
+    }
+    RAMP_To(target[OUTPUT_RED], target[OUTPUT_GREEN], target[OUTPUT_BLUE], target[OUTPUT_WHITE], steps);
+
+    while(RAMP_IsActive() && taken <= steps && (stopAfter == 0 || taken < stopAfter)) {
+        RAMP_Task();
+        taken++;
+        for(uint8_t i = 0; i < OUTPUT_CHANNEL_COUNT; i++) {
+            uint16_t level = OUTPUT_GetChannel((OutputChannel_t)i);
+            bool up = target[i] >= start[i];
+            double line = start[i] + ((double)target[i] - start[i]) * taken / steps;
+
+            CHECK(up ? level >= previous[i] && level <= target[i] : level <= previous[i] && level >= target[i],
+                  "%s: channel %u went from %u to %u at step %u", what, i, previous[i], level, taken);
+            CHECK(fabs(level - line) <= lag, "%s: channel %u at %u, %.1f on the line at step %u",
+                  what, i, level, line, taken);
+            previous[i] = level;
+        }
+    }
+
+    if(stopAfter == 0) {
+        CHECK(taken == steps, "%s: %u steps, expected %u", what, taken, steps);
+        for(uint8_t i = 0; i < OUTPUT_CHANNEL_COUNT; i++) {
+            CHECK(previous[i] == target[i], "%s: channel %u ended on %u, expected %u",
+                  what, i, previous[i], target[i]);
+        }
+    }
+}
+
+int main(void)
+{
+    uint32_t steps = RAMP_MINUTES_TO_STEPS(RAMP_MINUTES);
+    uint16_t level;
+
+    TMR2_Initialize();
+    OUTPUT_Initialize();
+    FADE_Initialize();
+
+    OUTPUT_SetRGBW(0, 0, 0, 0);
+    ramp(full, steps, 0, "sunrise");
+    ramp(off, steps, 0, "sunset");
+    ramp(mixed, steps, 0, "to a colour");
+    ramp(full, steps, 0, "from a colour");
+
+    // a long press halfway through a sunset turns it around from where it is
+    OUTPUT_SetRGBW(0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF);
+    ramp(off, steps, steps / 2, "sunset turned around");
+    CHECK(RAMP_IsActive(), "sunset ended halfway");
+    ramp(full, steps, 0, "sunrise after the turn");
+
+    // stopped, the outputs hold their levels
+    ramp(off, steps, steps / 4, "stopped sunset");
+    level = OUTPUT_GetChannel(OUTPUT_WHITE);
+    RAMP_Stop();
+    RAMP_Task();
+    CHECK(!RAMP_IsActive() && OUTPUT_GetChannel(OUTPUT_WHITE) == level, "ramp still running after RAMP_Stop()");
+
+    // one set of accumulators, a fade replaces the ramp and the other way round
+    ramp(off, steps, steps / 4, "ramp before a fade");
+    FADE_To(mixed[OUTPUT_RED], mixed[OUTPUT_GREEN], mixed[OUTPUT_BLUE], mixed[OUTPUT_WHITE], 10);
+    CHECK(!RAMP_IsActive() && FADE_IsActive(), "a fade did not replace the ramp");
+    RAMP_Stop();
+    CHECK(FADE_IsActive(), "RAMP_Stop() stopped a fade");
+    ramp(full, steps, 0, "ramp after a fade");
+    CHECK(!FADE_IsActive(), "the fade ran on under a ramp");
+
+    // no duration sets the target at once
+    RAMP_To(mixed[OUTPUT_RED], mixed[OUTPUT_GREEN], mixed[OUTPUT_BLUE], mixed[OUTPUT_WHITE], 0);
+    CHECK(!RAMP_IsActive() && OUTPUT_GetChannel(OUTPUT_BLUE) == mixed[OUTPUT_BLUE],
+          "a ramp without steps did not set the target");
+
+    return check_exit("test_ramp");
+}
@@ -0,0 +1,280 @@
+/*
+ * Scripted scenarios on the simulated device
+ *
+ *     ./test_scenarios
+ *
+ * Every scenario boots the firmware from the EEPROM image, drives the
+ * button and compares the average output of a window with the duties the
+ * preset table asks for. A scenario runs in a child process of its own,
+ * so each one starts from the initial RAM of the firmware.
+ */
+
+#include <math.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "check.h"
+#include "sim.h"
+#include "output.h"
+#include "preset.h"
+#include "gamma.h"
+#include "journal.h"
+#include "ramp.h"
+#include "moon.h"
+
+// length of an averaging window
+#define WINDOW              SIM_MS(500)
+
+// duty fraction, a dithered code of the slow clock profile is 1 / 6144
+#define TOLERANCE           0.0005
+
+#define LONG_PRESS_TIME     SIM_MS(1500)
+#define DOUBLE_PRESS_GAP    SIM_MS(150)
+#define BOOT_HOLD_TIME      SIM_MS(500)
+
+// firmware settings, see main.c
+extern uint8_t state;
+extern bool night;
+
+static const char *const names[OUTPUT_CHANNEL_COUNT] = { "red", "green", "blue", "white" };
+static const SimPwm_t pwmOf[OUTPUT_CHANNEL_COUNT] = { SIM_CCP2, SIM_CCP1, SIM_PWM5, SIM_PWM6 };
+
+// on time of every output at the start and the end of a window
+typedef struct Window {
+    double start[SIM_PWM_COUNT];
+    double end[SIM_PWM_COUNT];
+} Window_t;
+
+// journal passed from one scenario to the next
+static uint8_t *savedEeprom;
+
+static void markStart(void *arg)
+{
+    Window_t *window = arg;
+
+    for(uint8_t i = 0; i < SIM_PWM_COUNT; i++) {
+        window->start[i] = sim_on_time((SimPwm_t)i);
+    }
+}
+
+static void markEnd(void *arg)
+{
+    Window_t *window = arg;
+
+    for(uint8_t i = 0; i < SIM_PWM_COUNT; i++) {
+        window->end[i] = sim_on_time((SimPwm_t)i);
+    }
+}
+
+// average a window from a point of time, read it after sim_run()
+static void measure(Window_t *window, sim_time_t at)
+{
+    sim_at(at, markStart, window);
+    sim_at(at + WINDOW, markEnd, window);
+}
+
+static double average(const Window_t *window, OutputChannel_t channel)
+{
+    SimPwm_t pwm = pwmOf[channel];
+
+    return (window->end[pwm] - window->start[pwm]) / SIM_TO_SECONDS(WINDOW);
+}
+
+static void checkLevels(const Window_t *window, const uint16_t *levels, const char *what)
+{
+    for(uint8_t i = 0; i < OUTPUT_CHANNEL_COUNT; i++) {
+        double expected = levels[i] / 65536.0;
+        double actual = average(window, (OutputChannel_t)i);
+
+        CHECK(fabs(actual - expected) <= TOLERANCE, "%s: %s %.4f, expected %.4f",
+              what, names[i], actual, expected);
+    }
+}
+
+static void checkPreset(const Window_t *window, PanelType_t panel, uint8_t level, const char *what)
+{
+    const uint8_t *brightness = PRESET_GetBrightness(panel, level);
+    uint16_t levels[OUTPUT_CHANNEL_COUNT];
+
+    for(uint8_t i = 0; i < OUTPUT_CHANNEL_COUNT; i++) {
+        levels[i] = GAMMA_LEVEL(brightness[i]);
+    }
+    checkLevels(window, levels, what);
+}
+
+static void run(sim_time_t duration)
+{
+    CHECK(sim_run(duration), "asleep with nothing to wake it at %.3f s", SIM_TO_SECONDS(sim_now()));
+    CHECK(sim_stats()->eepromFaults == 0, "%u NVM faults", sim_stats()->eepromFaults);
+}
+
+static void checkJournal(uint8_t expectedState, PanelType_t expectedPanel)
+{
+    JournalRecord_t record;
+
+    CHECK(JOURNAL_Read(&record), "no journal record");
+    CHECK(record.state == expectedState && record.panel == expectedPanel,
+          "journal state %u panel %u, expected %u and %u",
+          record.state, record.panel, expectedState, expectedPanel);
+}
+
+// the image seeds state 0, the panel starts from its first level
+static void boot(void)
+{
+    Window_t level;
+
+    measure(&level, SIM_SECONDS(3));
+    run(SIM_SECONDS(4));
+    checkPreset(&level, BIG, 1, "boot");
+    CHECK(sim_stats()->eepromWrites == 0, "%u EEPROM writes", sim_stats()->eepromWrites);
+}
+
+static void shortPress(void)
+{
+    Window_t before, after;
+
+    sim_button(SIM_SECONDS(1), SIM_PRESS_TIME);
+    measure(&before, SIM_SECONDS(1));
+    measure(&after, SIM_SECONDS(3));
+    run(SIM_SECONDS(6));
+    checkPreset(&before, BIG, 1, "while pressed");
+    checkPreset(&after, BIG, 2, "short press");
+    checkJournal(2, BIG);
+}
+
+// straight to the brightest level, no step on the way
+static void doublePress(void)
+{
+    Window_t after;
+
+    sim_button(SIM_SECONDS(1), SIM_PRESS_TIME);
+    sim_button(SIM_SECONDS(1) + SIM_PRESS_TIME + DOUBLE_PRESS_GAP, SIM_PRESS_TIME);
+    measure(&after, SIM_SECONDS(3));
+    run(SIM_SECONDS(6));
+    checkPreset(&after, BIG, PRESET_LEVEL_COUNT, "double press");
+    checkJournal(PRESET_LEVEL_COUNT, BIG);
+    CHECK(sim_stats()->eepromWrites == JOURNAL_RECORD_SIZE, "%u EEPROM writes, expected one record",
+          sim_stats()->eepromWrites);
+}
+
+// a sunset from the first level down to the moonlight, the state is not stepped first
+static void longPress(void)
+{
+    uint16_t moon[OUTPUT_CHANNEL_COUNT];
+    Window_t start, moonlit;
+
+    sim_button(SIM_SECONDS(1), LONG_PRESS_TIME);
+    measure(&start, SIM_SECONDS(2));
+    measure(&moonlit, SIM_SECONDS(1) + SIM_SECONDS(60 * RAMP_DEFAULT_MINUTES));
+    run(SIM_SECONDS(1) + SIM_SECONDS(60 * RAMP_DEFAULT_MINUTES) + WINDOW);
+    MOON_GetLevels(presetMoonlight, moon);
+    checkPreset(&start, BIG, 1, "sunset start");
+    checkLevels(&moonlit, moon, "after the sunset");
+    CHECK(state == 1 && night, "state %u night %d after a long press", state, night);
+    CHECK(sim_stats()->eepromWrites == 0, "%u EEPROM writes", sim_stats()->eepromWrites);
+}
+
+// a second long press turns the sunset around into a sunrise
+static void sunrise(void)
+{
+    sim_time_t reverse = SIM_SECONDS(4 + 10 * 60);
+    Window_t turn, rising, day;
+
+    sim_button(SIM_SECONDS(1), SIM_PRESS_TIME);
+    sim_button(SIM_SECONDS(1) + SIM_PRESS_TIME + DOUBLE_PRESS_GAP, SIM_PRESS_TIME);
+    sim_button(SIM_SECONDS(4), LONG_PRESS_TIME);
+    sim_button(reverse, LONG_PRESS_TIME);
+    measure(&turn, reverse);
+    measure(&rising, reverse + SIM_SECONDS(5 * 60));
+    measure(&day, reverse + SIM_SECONDS(1) + SIM_SECONDS(60 * RAMP_DEFAULT_MINUTES));
+    run(reverse + SIM_SECONDS(1) + SIM_SECONDS(60 * RAMP_DEFAULT_MINUTES) + WINDOW);
+
+    for(uint8_t i = 0; i < OUTPUT_CHANNEL_COUNT; i++) {
+        double full = GAMMA_LEVEL(PRESET_GetBrightness(BIG, PRESET_LEVEL_COUNT)[i]) / 65536.0;
+
+        CHECK(average(&turn, (OutputChannel_t)i) < full - TOLERANCE, "%s did not fall in the sunset", names[i]);
+        CHECK(average(&rising, (OutputChannel_t)i) > average(&turn, (OutputChannel_t)i) + TOLERANCE,
+              "%s did not rise after the second long press", names[i]);
+    }
+    checkPreset(&day, BIG, PRESET_LEVEL_COUNT, "after the sunrise");
+    CHECK(state == PRESET_LEVEL_COUNT && !night, "state %u night %d after the sunrise", state, night);
+}
+
+// holding the button at power-up switches the panel and nothing else
+static void bootHold(void)
+{
+    Window_t level;
+
+    sim_button(0, BOOT_HOLD_TIME);
+    measure(&level, SIM_SECONDS(3));
+    run(SIM_SECONDS(4));
+    checkPreset(&level, SMALL, 1, "boot hold");
+    checkJournal(0, SMALL);
+}
+
+static void saveLevel(void)
+{
+    sim_button(SIM_SECONDS(1), SIM_PRESS_TIME);
+    sim_button(SIM_SECONDS(3), SIM_PRESS_TIME);
+    run(SIM_SECONDS(8));
+    checkJournal(3, BIG);
+    memcpy(savedEeprom, sim_eeprom(), SIM_EEPROM_SIZE);
+}
+
+// a power cycle comes back to the saved level
+static void restoreLevel(void)
+{
+    Window_t level;
+
+    memcpy(sim_eeprom(), savedEeprom, SIM_EEPROM_SIZE);
+    measure(&level, SIM_SECONDS(2));
+    run(SIM_SECONDS(3));
+    checkPreset(&level, BIG, 3, "restored");
+}
+
+static const struct {
+    const char *name;
+    void (*scenario)(void);
+} scenarios[] = {
+    { "boot",           boot },
+    { "short press",    shortPress },
+    { "double press",   doublePress },
+    { "long press",     longPress },
+    { "sunrise",        sunrise },
+    { "boot hold",      bootHold },
+    { "save level",     saveLevel },
+    { "restore level",  restoreLevel },
+};
+
+int main(void)
+{
+    savedEeprom = mmap(NULL, SIM_EEPROM_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if(savedEeprom == MAP_FAILED) {
+        perror("mmap");
+        return EXIT_FAILURE;
+    }
+
+    for(size_t i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++) {
+        pid_t pid;
+        int status;
+        bool passed;
+
+        fflush(stdout);
+        pid = fork();
+        if(pid == 0) {
+            checkFailures = 0;
+            sim_reset();
+            scenarios[i].scenario();
+            fflush(stdout);
+            _exit(checkFailures ? EXIT_FAILURE : EXIT_SUCCESS);
+        }
+        passed = pid > 0 && waitpid(pid, &status, 0) == pid &&
+                 WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS;
+        if(!passed) {
+            checkFailures++;
+        }
+        printf("  %-22s %s\n", scenarios[i].name, passed ? "ok" : "FAILED");
+    }
+    return check_exit("test_scenarios");
+}
@@ -0,0 +1,132 @@
+/*
+ * Value change dump of the simulated PWM outputs and the button
+ */
+
+#include <stdio.h>
+#include "vcd.h"
+
+// 31.25 ns HFINTOSC cycle in the 10 ps timescale
+#define STEPS_PER_CYCLE     3125ULL
+#define NEVER               UINT64_MAX
+#define BUTTON              SIM_PWM_COUNT
+#define SIGNAL_COUNT        (SIM_PWM_COUNT + 1)
+
+// SimPwm_t order, then the button
+static const char ids[SIGNAL_COUNT] = { '!', '"', '#', '$', '%' };
+static const char *const names[SIGNAL_COUNT] = {
+    "RA0_green", "RA1_red", "RA2_blue", "RA4_white", "RA5_button"
+};
+
+static FILE *file;
+static sim_time_t written;
+static char value[SIGNAL_COUNT];
+static sim_time_t fall[SIM_PWM_COUNT];     // pending falling edge of the running period
+
+static void change(sim_time_t time, uint8_t signal, char level)
+{
+    if(value[signal] == level) {
+        return;
+    }
+    if(time != written) {
+        fprintf(file, "#%llu\n", (unsigned long long)(time * STEPS_PER_CYCLE));
+        written = time;
+    }
+    fprintf(file, "%c%c\n", level, ids[signal]);
+    value[signal] = level;
+}
+
+// falling edges up to a time, earliest first
+static void flush(sim_time_t time)
+{
+    for(;;) {
+        uint8_t next = SIM_PWM_COUNT;
+        sim_time_t at = time;
+
+        for(uint8_t i = 0; i < SIM_PWM_COUNT; i++) {
+            if(fall[i] <= at) {
+                at = fall[i];
+                next = i;
+            }
+        }
+        if(next == SIM_PWM_COUNT) {
+            return;
+        }
+        change(at, next, '0');
+        fall[next] = NEVER;
+    }
+}
+
+bool vcd_open(const char *path, sim_time_t time, bool button)
+{
+    file = fopen(path, "w");
+    if(!file) {
+        return false;
+    }
+
+    fprintf(file, "$version aquaLed PIC16F18313 simulator $end\n");
+    fprintf(file, "$timescale 10ps $end\n");
+    fprintf(file, "$scope module aqualed $end\n");
+    for(uint8_t i = 0; i < SIGNAL_COUNT; i++) {
+        fprintf(file, "$var wire 1 %c %s $end\n", ids[i], names[i]);
+    }
+    fprintf(file, "$upscope $end\n$enddefinitions $end\n");
+
+    // the outputs are unknown until the first period starts
+    for(uint8_t i = 0; i < SIM_PWM_COUNT; i++) {
+        value[i] = 'x';
+        fall[i] = NEVER;
+    }
+    value[BUTTON] = button ? '1' : '0';
+    written = time;
+    fprintf(file, "#%llu\n$dumpvars\n", (unsigned long long)(time * STEPS_PER_CYCLE));
+    for(uint8_t i = 0; i < SIGNAL_COUNT; i++) {
+        fprintf(file, "%c%c\n", value[i], ids[i]);
+    }
+    fprintf(file, "$end\n");
+    return true;
+}
+
+void vcd_period(const SimPeriod_t *period)
+{
+    if(!file) {
+        return;
+    }
+    flush(period->start);
+
+    for(uint8_t i = 0; i < SIM_PWM_COUNT; i++) {
+        uint16_t duty = period->duty[i];
+
+        // a cut short period never reached the falling edge
+        fall[i] = NEVER;
+        if(!duty) {
+            change(period->start, i, '0');
+        } else {
+            change(period->start, i, '1');
+            if(duty < period->period) {
+                fall[i] = period->start + duty * period->dutyCount;
+            }
+        }
+    }
+}
+
+void vcd_button(sim_time_t time, bool level)
+{
+    if(!file) {
+        return;
+    }
+    flush(time);
+    change(time, BUTTON, level ? '1' : '0');
+}
+
+void vcd_close(sim_time_t time)
+{
+    if(!file) {
+        return;
+    }
+    flush(time);
+    if(time != written) {
+        fprintf(file, "#%llu\n", (unsigned long long)(time * STEPS_PER_CYCLE));
+    }
+    fclose(file);
+    file = NULL;
+}
@@ -0,0 +1,42 @@
+/*
+ * Value change dump of the simulated PWM outputs and the button
+ *
+ * Draws RA0 (green), RA1 (red), RA2 (blue), RA4 (white) from the period
+ * reports of the simulator and RA5 (button) from its input changes, for
+ * GTKWave and friends. An output rises at the period match and falls after
+ * its duty; a period cut short by a TMR2 write ends the high phase early,
+ * like the hardware. Times are in 10 ps steps, HFINTOSC cycles are 31.25 ns.
+ */
+
+#ifndef VCD_H
+#define VCD_H
+
+#include <stdbool.h>
+#include "sim.h"
+
+/**
+ * Create the file and write the header
+ * @param path file to write
+ * @param time start of the dump
+ * @param button button input level at the start
+ * @return false if the file cannot be created
+ */
+bool vcd_open(const char *path, sim_time_t time, bool button);
+
+/**
+ * Add a period, see sim_on_period()
+ */
+void vcd_period(const SimPeriod_t *period);
+
+/**
+ * Add a button input change, see sim_on_button()
+ */
+void vcd_button(sim_time_t time, bool level);
+
+/**
+ * Write the edges still due and close the file
+ * @param time end of the dump
+ */
+void vcd_close(sim_time_t time);
+
+#endif // VCD_H
@@ -0,0 +1,567 @@
+/*
+ * Host replacement for the XC8 <xc.h> device header (PIC16F18313)
+ *
+ * Every special function register lives in one register file so the
+ * firmware sources build unchanged with a native compiler. Each SFR access
+ * made through the register names below is counted in host_sfr_accesses.
+ * A simulator can hook the accesses, the delays and SLEEP (see sim.h).
+ */
+
+#ifndef XC_H
+#define XC_H
+
+#include <stdint.h>
+
+typedef union {
+    uint8_t reg;
+    struct {
+        unsigned T2CKPS  :2;
+        unsigned TMR2ON  :1;
+        unsigned T2OUTPS :4;
+        unsigned         :1;
+    };
+} T2CONbits_t;
+
+typedef union {
+    uint8_t reg;
+    struct {
+        unsigned INTF    :1;
+        unsigned         :3;
+        unsigned IOCIF   :1;
+        unsigned TMR0IF  :1;
+        unsigned         :2;
+    };
+} PIR0bits_t;
+
+typedef union {
+    uint8_t reg;
+    struct {
+        unsigned INTE    :1;
+        unsigned         :3;
+        unsigned IOCIE   :1;
+        unsigned TMR0IE  :1;
+        unsigned         :2;
+    };
+} PIE0bits_t;
+
+typedef union {
+    uint8_t reg;
+    struct {
+        unsigned TMR1IF  :1;
+        unsigned TMR2IF  :1;
+        unsigned BCL1IF  :1;
+        unsigned SSP1IF  :1;
+        unsigned TXIF    :1;
+        unsigned RCIF    :1;
+        unsigned ADIF    :1;
+        unsigned TMR1GIF :1;
+    };
+} PIR1bits_t;
+
+typedef union {
+    uint8_t reg;
+    struct {
+        unsigned TMR1IE  :1;
+        unsigned TMR2IE  :1;
+        unsigned BCL1IE  :1;
+        unsigned SSP1IE  :1;
+        unsigned TXIE    :1;
+        unsigned RCIE    :1;
+        unsigned ADIE    :1;
+        unsigned TMR1GIE :1;
+    };
+} PIE1bits_t;
+
+typedef union {
+    uint8_t reg;
+    struct {
+        unsigned NCO1IF  :1;
+        unsigned         :3;
+        unsigned NVMIF   :1;
+        unsigned         :1;
+        unsigned C1IF    :1;
+        unsigned         :1;
+    };
+} PIR2bits_t;
+
+typedef union {
+    uint8_t reg;
+    struct {
+        unsigned NCO1IE  :1;
+        unsigned         :3;
+        unsigned NVMIE   :1;
+        unsigned         :1;
+        unsigned C1IE    :1;
+        unsigned         :1;
+    };
+} PIE2bits_t;
+
+typedef union {
+    uint8_t reg;
+    struct {
+        unsigned INTEDG  :1;
+        unsigned         :5;
+        unsigned PEIE    :1;
+        unsigned GIE     :1;
+    };
+} INTCONbits_t;
+
+typedef union {
+    uint8_t reg;
+    struct {
+        unsigned CCP1MODE :4;
+        unsigned CCP1FMT  :1;
+        unsigned CCP1OUT  :1;
+        unsigned          :1;
+        unsigned CCP1EN   :1;
+    };
+} CCP1CONbits_t;
+
+typedef union {
+    uint8_t reg;
+    struct {
+        unsigned CCP2MODE :4;
+        unsigned CCP2FMT  :1;
+        unsigned CCP2OUT  :1;
+        unsigned          :1;
+        unsigned CCP2EN   :1;
+    };
+} CCP2CONbits_t;
+
+typedef union {
+    uint8_t reg;
+    struct {
+        unsigned          :4;
+        unsigned PWM5POL  :1;
+        unsigned PWM5OUT  :1;
+        unsigned          :1;
+        unsigned PWM5EN   :1;
+    };
+} PWM5CONbits_t;
+
+typedef union {
+    uint8_t reg;
+    struct {
+        unsigned          :4;
+        unsigned PWM6POL  :1;
+        unsigned PWM6OUT  :1;
+        unsigned          :1;
+        unsigned PWM6EN   :1;
+    };
+} PWM6CONbits_t;
+
+typedef union {
+    uint8_t reg;
+    struct {
+        unsigned RD      :1;
+        unsigned WR      :1;
+        unsigned WREN    :1;
+        unsigned WRERR   :1;
+        unsigned FREE    :1;
+        unsigned LWLO    :1;
+        unsigned NVMREGS :1;
+        unsigned         :1;
+    };
+} NVMCON1bits_t;
+
+typedef union {
+    uint8_t reg;
+    struct {
+        unsigned RA0 :1;
+        unsigned RA1 :1;
+        unsigned RA2 :1;
+        unsigned RA3 :1;
+        unsigned RA4 :1;
+        unsigned RA5 :1;
+        unsigned     :2;
+    };
+} PORTAbits_t;
+
+typedef union {
+    uint8_t reg;
+    struct {
+        unsigned LATA0 :1;
+        unsigned LATA1 :1;
+        unsigned LATA2 :1;
+        unsigned       :1;
+        unsigned LATA4 :1;
+        unsigned LATA5 :1;
+        unsigned       :2;
+    };
+} LATAbits_t;
+
+typedef union {
+    uint8_t reg;
+    struct {
+        unsigned TRISA0 :1;
+        unsigned TRISA1 :1;
+        unsigned TRISA2 :1;
+        unsigned TRISA3 :1;
+        unsigned TRISA4 :1;
+        unsigned TRISA5 :1;
+        unsigned        :2;
+    };
+} TRISAbits_t;
+
+typedef union {
+    uint8_t reg;
+    struct {
+        unsigned ANSA0 :1;
+        unsigned ANSA1 :1;
+        unsigned ANSA2 :1;
+        unsigned       :1;
+        unsigned ANSA4 :1;
+        unsigned ANSA5 :1;
+        unsigned       :2;
+    };
+} ANSELAbits_t;
+
+typedef union {
+    uint8_t reg;
+    struct {
+        unsigned WPUA0 :1;
+        unsigned WPUA1 :1;
+        unsigned WPUA2 :1;
+        unsigned WPUA3 :1;
+        unsigned WPUA4 :1;
+        unsigned WPUA5 :1;
+        unsigned       :2;
+    };
+} WPUAbits_t;
+
+typedef union {
+    uint8_t reg;
+    struct {
+        unsigned ODCA0 :1;
+        unsigned ODCA1 :1;
+        unsigned ODCA2 :1;
+        unsigned       :1;
+        unsigned ODCA4 :1;
+        unsigned ODCA5 :1;
+        unsigned       :2;
+    };
+} ODCONAbits_t;
+
+typedef union {
+    uint8_t reg;
+    struct {
+        unsigned IOCAP0 :1;
+        unsigned IOCAP1 :1;
+        unsigned IOCAP2 :1;
+        unsigned IOCAP3 :1;
+        unsigned IOCAP4 :1;
+        unsigned IOCAP5 :1;
+        unsigned        :2;
+    };
+} IOCAPbits_t;
+
+typedef union {
+    uint8_t reg;
+    struct {
+        unsigned IOCAN0 :1;
+        unsigned IOCAN1 :1;
+        unsigned IOCAN2 :1;
+        unsigned IOCAN3 :1;
+        unsigned IOCAN4 :1;
+        unsigned IOCAN5 :1;
+        unsigned        :2;
+    };
+} IOCANbits_t;
+
+typedef union {
+    uint8_t reg;
+    struct {
+        unsigned IOCAF0 :1;
+        unsigned IOCAF1 :1;
+        unsigned IOCAF2 :1;
+        unsigned IOCAF3 :1;
+        unsigned IOCAF4 :1;
+        unsigned IOCAF5 :1;
+        unsigned        :2;
+    };
+} IOCAFbits_t;
+
+typedef union {
+    uint8_t reg;
+    struct {
+        unsigned NDIV :4;
+        unsigned NOSC :3;
+        unsigned      :1;
+    };
+} OSCCON1bits_t;
+
+typedef union {
+    uint8_t reg;
+    struct {
+        unsigned CDIV :4;
+        unsigned COSC :3;
+        unsigned      :1;
+    };
+} OSCCON2bits_t;
+
+typedef union {
+    uint8_t reg;
+    struct {
+        unsigned         :3;
+        unsigned NOSCR   :1;
+        unsigned ORDY    :1;
+        unsigned         :1;
+        unsigned SOSCPWR :1;
+        unsigned CSWHOLD :1;
+    };
+} OSCCON3bits_t;
+
+typedef union {
+    uint8_t reg;
+    struct {
+        unsigned IOCMD  :1;
+        unsigned CLKRMD :1;
+        unsigned NVMMD  :1;
+        unsigned        :3;
+        unsigned FVRMD  :1;
+        unsigned SYSCMD :1;
+    };
+} PMD0bits_t;
+
+typedef union {
+    uint8_t reg;
+    struct {
+        unsigned TMR0MD :1;
+        unsigned TMR1MD :1;
+        unsigned TMR2MD :1;
+        unsigned        :4;
+        unsigned NCOMD  :1;
+    };
+} PMD1bits_t;
+
+typedef union {
+    uint8_t reg;
+    struct {
+        unsigned        :1;
+        unsigned CMP1MD :1;
+        unsigned        :3;
+        unsigned ADCMD  :1;
+        unsigned DACMD  :1;
+        unsigned        :1;
+    };
+} PMD2bits_t;
+
+typedef union {
+    uint8_t reg;
+    struct {
+        unsigned CCP1MD :1;
+        unsigned CCP2MD :1;
+        unsigned        :2;
+        unsigned PWM5MD :1;
+        unsigned PWM6MD :1;
+        unsigned CWG1MD :1;
+        unsigned        :1;
+    };
+} PMD3bits_t;
+
+typedef union {
+    uint8_t reg;
+    struct {
+        unsigned         :1;
+        unsigned MSSP1MD :1;
+        unsigned         :3;
+        unsigned UART1MD :1;
+        unsigned         :2;
+    };
+} PMD4bits_t;
+
+typedef union {
+    uint8_t reg;
+    struct {
+        unsigned DSMMD  :1;
+        unsigned CLC1MD :1;
+        unsigned CLC2MD :1;
+        unsigned        :5;
+    };
+} PMD5bits_t;
+
+typedef union {
+    uint8_t reg;
+    struct {
+        unsigned DOZE  :3;
+        unsigned       :1;
+        unsigned DOE   :1;
+        unsigned ROI   :1;
+        unsigned DOZEN :1;
+        unsigned IDLEN :1;
+    };
+} CPUDOZEbits_t;
+
+typedef union {
+    uint8_t reg;
+    struct {
+        unsigned        :1;
+        unsigned VREGPM :1;
+        unsigned        :6;
+    };
+} VREGCONbits_t;
+
+typedef struct {
+    uint8_t sfr_PR2, sfr_TMR2;
+    T2CONbits_t sfr_T2CON;
+    PIR0bits_t sfr_PIR0;
+    PIE0bits_t sfr_PIE0;
+    PIR1bits_t sfr_PIR1;
+    PIE1bits_t sfr_PIE1;
+    PIR2bits_t sfr_PIR2;
+    PIE2bits_t sfr_PIE2;
+    INTCONbits_t sfr_INTCON;
+    CCP1CONbits_t sfr_CCP1CON;
+    uint8_t sfr_CCPR1H, sfr_CCPR1L;
+    CCP2CONbits_t sfr_CCP2CON;
+    uint8_t sfr_CCPR2H, sfr_CCPR2L;
+    PWM5CONbits_t sfr_PWM5CON;
+    uint8_t sfr_PWM5DCH, sfr_PWM5DCL;
+    PWM6CONbits_t sfr_PWM6CON;
+    uint8_t sfr_PWM6DCH, sfr_PWM6DCL;
+    uint8_t sfr_NVMADRL, sfr_NVMADRH, sfr_NVMDATL, sfr_NVMDATH;
+    NVMCON1bits_t sfr_NVMCON1;
+    uint8_t sfr_NVMCON2;
+    PORTAbits_t sfr_PORTA;
+    LATAbits_t sfr_LATA;
+    TRISAbits_t sfr_TRISA;
+    ANSELAbits_t sfr_ANSELA;
+    WPUAbits_t sfr_WPUA;
+    ODCONAbits_t sfr_ODCONA;
+    uint8_t sfr_SLRCONA;
+    IOCAPbits_t sfr_IOCAP;
+    IOCANbits_t sfr_IOCAN;
+    IOCAFbits_t sfr_IOCAF;
+    uint8_t sfr_RA0PPS, sfr_RA1PPS, sfr_RA2PPS, sfr_RA4PPS;
+    OSCCON1bits_t sfr_OSCCON1;
+    OSCCON2bits_t sfr_OSCCON2;
+    OSCCON3bits_t sfr_OSCCON3;
+    uint8_t sfr_OSCEN, sfr_OSCFRQ, sfr_OSCTUNE, sfr_OSCSTAT1, sfr_WDTCON;
+    PMD0bits_t sfr_PMD0;
+    PMD1bits_t sfr_PMD1;
+    PMD2bits_t sfr_PMD2;
+    PMD3bits_t sfr_PMD3;
+    PMD4bits_t sfr_PMD4;
+    PMD5bits_t sfr_PMD5;
+    CPUDOZEbits_t sfr_CPUDOZE;
+    VREGCONbits_t sfr_VREGCON;
+} HostSfrFile_t;
+
+extern volatile HostSfrFile_t host_sfr;
+extern unsigned long host_sfr_accesses;
+
+// optional hooks, called before the access, for the delay and on SLEEP
+extern void (*host_sfr_hook)(volatile void *sfr);
+extern void (*host_delay_hook)(unsigned long us);
+extern void (*host_sleep_hook)(void);
+
+// count one access and return the register file field
+volatile void *host_sfr_access(volatile void *sfr);
+#define HOST_SFR(field)     (*(__typeof__(&host_sfr.field))host_sfr_access(&host_sfr.field))
+
+#define PR2         HOST_SFR(sfr_PR2)
+#define TMR2        HOST_SFR(sfr_TMR2)
+#define T2CON       HOST_SFR(sfr_T2CON.reg)
+#define T2CONbits   HOST_SFR(sfr_T2CON)
+#define PIR0        HOST_SFR(sfr_PIR0.reg)
+#define PIR0bits    HOST_SFR(sfr_PIR0)
+#define PIE0        HOST_SFR(sfr_PIE0.reg)
+#define PIE0bits    HOST_SFR(sfr_PIE0)
+#define PIR1        HOST_SFR(sfr_PIR1.reg)
+#define PIR1bits    HOST_SFR(sfr_PIR1)
+#define PIE1        HOST_SFR(sfr_PIE1.reg)
+#define PIE1bits    HOST_SFR(sfr_PIE1)
+#define PIR2        HOST_SFR(sfr_PIR2.reg)
+#define PIR2bits    HOST_SFR(sfr_PIR2)
+#define PIE2        HOST_SFR(sfr_PIE2.reg)
+#define PIE2bits    HOST_SFR(sfr_PIE2)
+#define INTCON      HOST_SFR(sfr_INTCON.reg)
+#define INTCONbits  HOST_SFR(sfr_INTCON)
+#define CCP1CON     HOST_SFR(sfr_CCP1CON.reg)
+#define CCP1CONbits HOST_SFR(sfr_CCP1CON)
+#define CCPR1H      HOST_SFR(sfr_CCPR1H)
+#define CCPR1L      HOST_SFR(sfr_CCPR1L)
+#define CCP2CON     HOST_SFR(sfr_CCP2CON.reg)
+#define CCP2CONbits HOST_SFR(sfr_CCP2CON)
+#define CCPR2H      HOST_SFR(sfr_CCPR2H)
+#define CCPR2L      HOST_SFR(sfr_CCPR2L)
+#define PWM5CON     HOST_SFR(sfr_PWM5CON.reg)
+#define PWM5CONbits HOST_SFR(sfr_PWM5CON)
+#define PWM5DCH     HOST_SFR(sfr_PWM5DCH)
+#define PWM5DCL     HOST_SFR(sfr_PWM5DCL)
+#define PWM6CON     HOST_SFR(sfr_PWM6CON.reg)
+#define PWM6CONbits HOST_SFR(sfr_PWM6CON)
+#define PWM6DCH     HOST_SFR(sfr_PWM6DCH)
+#define PWM6DCL     HOST_SFR(sfr_PWM6DCL)
+#define NVMADRL     HOST_SFR(sfr_NVMADRL)
+#define NVMADRH     HOST_SFR(sfr_NVMADRH)
+#define NVMDATL     HOST_SFR(sfr_NVMDATL)
+#define NVMDATH     HOST_SFR(sfr_NVMDATH)
+#define NVMCON1     HOST_SFR(sfr_NVMCON1.reg)
+#define NVMCON1bits HOST_SFR(sfr_NVMCON1)
+#define NVMCON2     HOST_SFR(sfr_NVMCON2)
+#define PORTA       HOST_SFR(sfr_PORTA.reg)
+#define PORTAbits   HOST_SFR(sfr_PORTA)
+#define LATA        HOST_SFR(sfr_LATA.reg)
+#define LATAbits    HOST_SFR(sfr_LATA)
+#define TRISA       HOST_SFR(sfr_TRISA.reg)
+#define TRISAbits   HOST_SFR(sfr_TRISA)
+#define ANSELA      HOST_SFR(sfr_ANSELA.reg)
+#define ANSELAbits  HOST_SFR(sfr_ANSELA)
+#define WPUA        HOST_SFR(sfr_WPUA.reg)
+#define WPUAbits    HOST_SFR(sfr_WPUA)
+#define ODCONA      HOST_SFR(sfr_ODCONA.reg)
+#define ODCONAbits  HOST_SFR(sfr_ODCONA)
+#define SLRCONA     HOST_SFR(sfr_SLRCONA)
+#define IOCAP       HOST_SFR(sfr_IOCAP.reg)
+#define IOCAPbits   HOST_SFR(sfr_IOCAP)
+#define IOCAN       HOST_SFR(sfr_IOCAN.reg)
+#define IOCANbits   HOST_SFR(sfr_IOCAN)
+#define IOCAF       HOST_SFR(sfr_IOCAF.reg)
+#define IOCAFbits   HOST_SFR(sfr_IOCAF)
+#define RA0PPS      HOST_SFR(sfr_RA0PPS)
+#define RA1PPS      HOST_SFR(sfr_RA1PPS)
+#define RA2PPS      HOST_SFR(sfr_RA2PPS)
+#define RA4PPS      HOST_SFR(sfr_RA4PPS)
+#define OSCCON1     HOST_SFR(sfr_OSCCON1.reg)
+#define OSCCON1bits HOST_SFR(sfr_OSCCON1)
+#define OSCCON2     HOST_SFR(sfr_OSCCON2.reg)
+#define OSCCON2bits HOST_SFR(sfr_OSCCON2)
+#define OSCCON3     HOST_SFR(sfr_OSCCON3.reg)
+#define OSCCON3bits HOST_SFR(sfr_OSCCON3)
+#define OSCEN       HOST_SFR(sfr_OSCEN)
+#define OSCFRQ      HOST_SFR(sfr_OSCFRQ)
+#define OSCTUNE     HOST_SFR(sfr_OSCTUNE)
+#define OSCSTAT1    HOST_SFR(sfr_OSCSTAT1)
+#define WDTCON      HOST_SFR(sfr_WDTCON)
+#define PMD0        HOST_SFR(sfr_PMD0.reg)
+#define PMD0bits    HOST_SFR(sfr_PMD0)
+#define PMD1        HOST_SFR(sfr_PMD1.reg)
+#define PMD1bits    HOST_SFR(sfr_PMD1)
+#define PMD2        HOST_SFR(sfr_PMD2.reg)
+#define PMD2bits    HOST_SFR(sfr_PMD2)
+#define PMD3        HOST_SFR(sfr_PMD3.reg)
+#define PMD3bits    HOST_SFR(sfr_PMD3)
+#define PMD4        HOST_SFR(sfr_PMD4.reg)
+#define PMD4bits    HOST_SFR(sfr_PMD4)
+#define PMD5        HOST_SFR(sfr_PMD5.reg)
+#define PMD5bits    HOST_SFR(sfr_PMD5)
+#define CPUDOZE     HOST_SFR(sfr_CPUDOZE.reg)
+#define CPUDOZEbits HOST_SFR(sfr_CPUDOZE)
+#define VREGCON     HOST_SFR(sfr_VREGCON.reg)
+#define VREGCONbits HOST_SFR(sfr_VREGCON)
+
+// compiler intrinsics
+void host_delay_us(unsigned long us);
+void host_sleep(void);
+#define __delay_ms(ms)  host_delay_us((unsigned long)(ms) * 1000UL)
+#define __delay_us(us)  host_delay_us((unsigned long)(us))
+#define NOP()           ((void)0)
+#define CLRWDT()        ((void)0)
+#define SLEEP()         host_sleep()
+
+// storage and function qualifiers
+#define __interrupt(...)
+#define __eeprom
+
+#endif // XC_H
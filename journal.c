@@ -0,0 +1,155 @@
+/*
+ * Wear-levelled settings journal
+ */
+
+#include "mcc_generated_files/mcc.h"
+#include "journal.h"
+
+// record layout
+#define RECORD_SEQUENCE     0
+#define RECORD_STATE        1
+#define RECORD_PANEL        2
+#define RECORD_CHECKSUM     3
+
+static JournalRecord_t newest;
+static bool valid;
+static uint8_t newestSlot;
+static uint8_t sequence;
+
+// deferred save
+static JournalRecord_t pending;
+static bool dirty;
+static uint16_t idleTicks;
+
+// record being written, writeIndex == JOURNAL_RECORD_SIZE when idle
+static uint8_t writeBuffer[JOURNAL_RECORD_SIZE];
+static uint16_t writeAddr;
+static volatile uint8_t writeIndex = JOURNAL_RECORD_SIZE;
+
+// CRC-8, polynomial 0x07, init 0xFF: blank (0xFF) and zeroed slots never pass
+static uint8_t crc8(uint8_t crc, uint8_t data)
+{
+    crc ^= data;
+    for(uint8_t i = 0; i < 8; i++) {
+        crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+    }
+    return crc;
+}
+
+static uint8_t checksum(uint8_t seq, uint8_t state, uint8_t panel)
+{
+    return crc8(crc8(crc8(0xFF, seq), state), panel);
+}
+
+// NVM write complete, start the next byte of the record
+static void writeNextISR(void)
+{
+    if(++writeIndex < JOURNAL_RECORD_SIZE) {
+        DATAEE_StartWriteByte(writeAddr + writeIndex, writeBuffer[writeIndex]);
+    } else {
+        // record complete, the NVM is only clocked while writing
+        PMD_NVMDisable();
+    }
+}
+
+bool JOURNAL_Initialize(void)
+{
+    uint16_t addr = JOURNAL_BASE_ADDRESS;
+
+    valid = false;
+    dirty = false;
+    writeIndex = JOURNAL_RECORD_SIZE;
+    NVM_SetInterruptHandler(writeNextISR);
+    newestSlot = JOURNAL_SLOT_COUNT - 1;
+    sequence = 0;
+
+    for(uint8_t slot = 0; slot < JOURNAL_SLOT_COUNT; slot++, addr += JOURNAL_RECORD_SIZE) {
+        uint8_t seq = DATAEE_ReadByte(addr + RECORD_SEQUENCE);
+        uint8_t state = DATAEE_ReadByte(addr + RECORD_STATE);
+        uint8_t panel = DATAEE_ReadByte(addr + RECORD_PANEL);
+
+        if(DATAEE_ReadByte(addr + RECORD_CHECKSUM) != checksum(seq, state, panel)) {
+            continue;
+        }
+
+        // valid sequences span less than half of the 8 bit range,
+        // so serial number arithmetic orders them across the wrap
+        if(!valid || (int8_t)(seq - sequence) > 0) {
+            valid = true;
+            sequence = seq;
+            newestSlot = slot;
+            newest.state = state;
+            newest.panel = panel;
+        }
+    }
+    return valid;
+}
+
+bool JOURNAL_Read(JournalRecord_t *record)
+{
+    if(valid) {
+        *record = newest;
+    }
+    return valid;
+}
+
+// append a record in the next slot, returns once the first byte is started
+static void write(const JournalRecord_t *record)
+{
+    if(++newestSlot >= JOURNAL_SLOT_COUNT) {
+        newestSlot = 0;
+    }
+    if(valid) {
+        sequence++;
+    }
+
+    // checksum goes last, a write torn before it leaves a slot that fails the check
+    writeBuffer[RECORD_SEQUENCE] = sequence;
+    writeBuffer[RECORD_STATE] = record->state;
+    writeBuffer[RECORD_PANEL] = record->panel;
+    writeBuffer[RECORD_CHECKSUM] = checksum(sequence, record->state, record->panel);
+    writeAddr = JOURNAL_BASE_ADDRESS + (uint16_t)newestSlot * JOURNAL_RECORD_SIZE;
+    writeIndex = 0;
+    PMD_NVMEnable();
+    DATAEE_StartWriteByte(writeAddr, writeBuffer[0]);
+
+    newest = *record;
+    valid = true;
+}
+
+void JOURNAL_Save(const JournalRecord_t *record)
+{
+    pending = *record;
+    idleTicks = JOURNAL_IDLE_TICKS;
+
+    // back to the saved values before the idle time ran out, nothing to write
+    dirty = !valid || pending.state != newest.state || pending.panel != newest.panel;
+}
+
+void JOURNAL_Task(void)
+{
+    if(!dirty) {
+        return;
+    }
+    if(idleTicks) {
+        idleTicks--;
+        return;
+    }
+
+    // the previous record is still being written, try again on the next tick
+    if(writeIndex < JOURNAL_RECORD_SIZE) {
+        return;
+    }
+    dirty = false;
+    write(&pending);
+}
+
+bool JOURNAL_IsBusy(void)
+{
+    return dirty || writeIndex < JOURNAL_RECORD_SIZE;
+}
+
+bool JOURNAL_IsWriting(void)
+{
+    return writeIndex < JOURNAL_RECORD_SIZE;
+}
@@ -0,0 +1,73 @@
+/*
+ * Wear-levelled settings journal
+ *
+ * The 32 byte EEPROM block at 0xF000 - 0xF01F is used as a ring of
+ * 4 byte records: sequence, state, panel type, CRC-8. Every save goes
+ * to the slot after the newest one, so each cell takes 1/8 of the writes.
+ * The checksum is written last; a record torn by a reset fails the check
+ * and the previous record stays the newest one.
+ *
+ * Saves are deferred until the values have been stable for
+ * JOURNAL_IDLE_MS, so stepping through the levels costs one record.
+ * The record is then written byte by byte from the NVM write complete
+ * interrupt, the main loop never waits for the EEPROM. The NVM module
+ * is clocked for the write only, see PMD_NVMEnable().
+ */
+
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "scheduler.h"
+
+#define JOURNAL_BASE_ADDRESS    0xF000
+#define JOURNAL_SIZE            32
+#define JOURNAL_RECORD_SIZE     4
+#define JOURNAL_SLOT_COUNT      (JOURNAL_SIZE / JOURNAL_RECORD_SIZE)
+
+// values must stay unchanged this long before they are written
+#ifndef JOURNAL_IDLE_MS
+#define JOURNAL_IDLE_MS         2000
+#endif
+#define JOURNAL_IDLE_TICKS      SCHEDULER_MS_TO_TICKS(JOURNAL_IDLE_MS)
+
+typedef struct JournalRecord {
+    uint8_t state;
+    uint8_t panel;
+} JournalRecord_t;
+
+/**
+ * Find the newest valid record with one scan of the journal
+ * @return false if the journal holds no valid record
+ */
+bool JOURNAL_Initialize(void);
+
+/**
+ * @param record filled with the newest saved values
+ * @return false if nothing was saved yet, record is left untouched
+ */
+bool JOURNAL_Read(JournalRecord_t *record);
+
+/**
+ * Request a save, the record is written once it stayed unchanged for
+ * JOURNAL_IDLE_TICKS. Saving the newest record again cancels the request.
+ */
+void JOURNAL_Save(const JournalRecord_t *record);
+
+/**
+ * Idle countdown, scheduler task with a period of 1 tick
+ */
+void JOURNAL_Task(void);
+
+/**
+ * @return a save is pending or being written
+ */
+bool JOURNAL_IsBusy(void);
+
+/**
+ * @return a record is being written, the NVM is in use until it completes
+ */
+bool JOURNAL_IsWriting(void);
+
+#endif // JOURNAL_H
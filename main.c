@@ -13,18 +13,61 @@ VSS          ->  GND
  */
 
 #include "mcc_generated_files/mcc.h"
+#include "scheduler.h"
+#include "button.h"
+#include "output.h"
+#include "preset.h"
+#include "journal.h"
+#include "fade.h"
+#include "ramp.h"
+#include "gamma.h"
+#include "rtc.h"
+#include "photoperiod.h"
+#include "clock.h"
+#include "profile.h"
+#include "prng.h"
+#include "weather.h"
+#include "moon.h"
+#include "colour.h"
+#include "demo.h"
+
+// weather over the day scene, see weather.h
+#ifndef WEATHER_DEFAULT_MODE
+#define WEATHER_DEFAULT_MODE    WEATHER_CLEAR
+#endif
+
+// darkest and brightest preset levels of the panel state machine
+#define STATE_LEVEL_MIN         1
+#define STATE_LEVEL_MAX         PRESET_LEVEL_COUNT
 
 //Global variables
 uint8_t state = 0;
-uint16_t dataeeAddr = 0xF010;
+PanelType_t panelType = BIG;
+bool night = false;         // moonlight after a sunset, dark or moonlight after a program event, until the next press
+bool panelRendered = false; // state and panel type shown, cleared to redraw
+uint16_t randomInterval = RANDOM_STEP_TICKS;    // ticks between random colours
+uint16_t randomFadeTicks = RANDOM_FADE_TICKS;   // crossfade to the next one, 0 switches at once
+WeatherMode_t weatherMode = WEATHER_DEFAULT_MODE;
 
-// initialize eeprom with zeroes 0xF000 - 0xF01F
-__eeprom unsigned char eeprom_values[32] =
-        {   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  //  0xF000 - 0xF007
+// settings journal 0xF000 - 0xF01F, seeded with one record: sequence 0, state 0, panel BIG
+// photoperiod program 0xF020 - 0xF037, see photoperiod.h, shipped disabled: the
+// RTC cannot be set and would run it relative to power-up over the saved state.
+// Writing 0x01 to 0xF020 enables the example:
+//   07:30 dawn, 30 min ramp to level 4    10:00 midday peak, 30 min ramp to level 7
+//   13:00 siesta, 12 min ramp to level 3  15:00 back to level 7 in 12 min
+//   20:00 dusk, 60 min ramp to moonlight  23:00 off in 30 min
+__eeprom unsigned char eeprom_values[64] =
+        {   0x00, 0x00, 0x01, 0x2C, 0x00, 0x00, 0x00, 0x00,  //  0xF000 - 0xF007
             0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  //  0xF008 - 0xF00F
 
             0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  //  0xF010 - 0xF017
-            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00   //  0xF018 - 0xF01F
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  //  0xF018 - 0xF01F
+
+            0xFF, 0xC2, 0x54, 0x02, 0x58, 0x57, 0x03, 0x0C,  //  0xF020 - 0xF027
+            0x23, 0x03, 0x84, 0x27, 0x04, 0xB0, 0xAF, 0x05,  //  0xF028 - 0xF02F
+
+            0x64, 0x50, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  //  0xF030 - 0xF037
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF   //  0xF038 - 0xF03F
         };
 
 typedef enum PwmChannel {
@@ -35,267 +78,354 @@ typedef enum PwmChannel {
     PWM6 = 4
 } PwmChannel_t;
 
-typedef enum PanelType {
-    SMALL   = 0,
-    BIG     = 1
-} PanelType_t;
+/**
+ * Apply a button gesture to the state machine:
+ * press -> next level, double press -> brightest, long press -> sunset / sunrise.
+ * @param event debounced button event
+ * @return state changed or not
+ */
+bool ButtonCommand(ButtonEvent_t event);
+
+/**
+ * Ramp from the current output to the preset of the current state
+ */
+void sunrise(void);
 
 /**
- * Read button state and debugging. Only the press is detected.
- * Blocking function! Not returns until button is not released!
- * @return button pressed or not
+ * Ramp from the current output to tonight's moonlight, the panel stays
+ * there until a press
  */
-bool ButtonChangeCheck(void);
+void sunset(void);
+
+/**
+ * Move the output to tonight's moonlight, see moon.h
+ * @param rampMinutes ramp duration, 0 for a crossfade
+ */
+void moonlight(uint8_t rampMinutes);
+
+/**
+ * Move the output to a brightness
+ * @param brightness logical brightness of every channel, NULL for off
+ * @param rampMinutes ramp duration, 0 for a crossfade
+ */
+void lightTo(const uint8_t *brightness, uint8_t rampMinutes);
+
+/**
+ * Move the output to output levels, see lightTo()
+ * @param levels OUTPUT_CHANNEL_COUNT output levels
+ */
+void lightToLevels(const uint16_t *levels, uint8_t rampMinutes);
+
+/**
+ * Photoperiod program event, see PhotoperiodHandler_t
+ */
+void photoperiodEvent(uint8_t level, uint8_t rampMinutes);
+
+/**
+ * Idle the core until the next interrupt, unless a tick is already waiting.
+ * TMR2, the PWMs and the NVM keep running, any enabled interrupt wakes it.
+ */
+void idle(void)
+{
+    // with GIE off a pending interrupt flag still ends SLEEP, so a tick
+    // arriving after the check cannot be slept through
+    INTERRUPT_GlobalInterruptDisable();
+    if(!SCHEDULER_IsPending()) {
+        SLEEP();
+        NOP();
+    }
+    INTERRUPT_GlobalInterruptEnable();
+}
+
+/**
+ * TMR2 callback, runs in interrupt context on every tick
+ */
+void tickHandler(void)
+{
+    SCHEDULER_Tick();
+    BUTTON_SampleISR();
+}
 
 void setPWMValues(uint16_t dutyValue, const PwmChannel_t pwmMode);
+void fadePWMValues(uint16_t dutyValue, const PwmChannel_t pwmMode, uint16_t ticks);
+void fadeToColour(uint16_t hue, uint8_t saturation, uint8_t value, uint16_t ticks);
+
+/**
+ * Save state and panel type to the journal once they settle
+ */
+void saveSettings(void)
+{
+    JournalRecord_t record;
+
+    record.state = state;
+    record.panel = (uint8_t)panelType;
+    JOURNAL_Save(&record);
+}
 
 /**
  * Initialize led driver
  */
 void initialize(void)
 {
+    JournalRecord_t record;
+
     // initialize the device
     SYSTEM_Initialize();
+    OUTPUT_Initialize();
+    FADE_Initialize();
+    WEATHER_Initialize();
+    RTC_Initialize();
+    CLOCK_Initialize();
+    PROFILE_Initialize();
+
+    // TMR2 callback drives the tick scheduler and the button sampler
+    SCHEDULER_Initialize();
+    BUTTON_Initialize();
+    TMR2_SetInterruptHandler(tickHandler);
+    TMR2_SetPeriodHandler(OUTPUT_PeriodISR);
+    IOCAF5_SetInterruptHandler(BUTTON_ChangeISR);
+
+    // SLEEP idles the core only, the peripheral clock keeps running
+    CPUDOZEbits.IDLEN = 1;
 
     // start TMR2 timer
     TMR2_StartTimer();
 
-    // initialize state machine from memory
-    state = DATAEE_ReadByte(dataeeAddr);
+    // enable interrupts
+    INTERRUPT_GlobalInterruptEnable();
+    INTERRUPT_PeripheralInterruptEnable();
+
+    // initialize state machine and panel type from the newest journal record
+    JOURNAL_Initialize();
+    if(JOURNAL_Read(&record)) {
+        state = record.state;
+        panelType = (PanelType_t)record.panel;
+    }
+    if(panelType >= PRESET_PANEL_COUNT) {
+        panelType = BIG;
+    }
+
+    // holding the button at power up switches to the other panel type
+    __delay_ms(10); // let the pull-up settle
+    if(!Button_GetValue()) {
+        panelType = (panelType == BIG) ? SMALL : BIG;
+        saveSettings();
+        while(!Button_GetValue())
+            ; //wait until release, only at power up
+        __delay_ms(10); //wait for prell
+
+        // the sampler timed the hold as a gesture, it is not one
+        INTERRUPT_GlobalInterruptDisable();
+        BUTTON_Initialize();
+        INTERRUPT_GlobalInterruptEnable();
+    }
+
+    // the daily program, if there is one, takes over from the saved state
+    if(PHOTOPERIOD_Initialize()) {
+        PHOTOPERIOD_SetEventHandler(photoperiodEvent);
+        RTC_SetMinuteHandler(PHOTOPERIOD_MinuteHandler);
+        PHOTOPERIOD_Resume(RTC_GetMinutes());
+    }
+
+    // EEPROM reads are done, the journal clocks the NVM for its writes
+    PMD_NVMDisable();
 }
 
 /**
- * Light driving logic
+ * Light driving logic, non-blocking step called on every scheduler tick
  */
-void loop_small(void);
-void loop_big(void);
+void loop_panel(void);
+
+/**
+ * Weather step, called on every tick
+ */
+void loop_weather(void);
 
 /**
  * Main
  */
 void main(void)
 {
-    const PanelType_t panelType = BIG;
-
     // initialize
     initialize();
 
+    // execute state machine on every tick
+    SCHEDULER_AddTask(loop_panel, 1);
+    SCHEDULER_AddTask(FADE_Task, 1);
+    SCHEDULER_AddTask(loop_weather, 1);
+    SCHEDULER_AddTask(RAMP_Task, RAMP_STEP_TICKS);
+    SCHEDULER_AddTask(RTC_Task, RTC_TASK_TICKS);
+    SCHEDULER_AddTask(CLOCK_Task, 1);
+    SCHEDULER_AddTask(JOURNAL_Task, 1);
+
     // main loop
     while (true) {
-        if(ButtonChangeCheck()) {
-            // if button press detected change state
-            ++state;
+        ButtonEvent_t event;
 
-            // store state value to memory
-            DATAEE_WriteByte(dataeeAddr, state);
+        while((event = BUTTON_GetEvent()) != BUTTON_EVENT_NONE) {
+            if(ButtonCommand(event)) {
+                // store state value to memory when it settles
+                saveSettings();
+            }
         }
 
-        // execute state machine
-        switch(panelType) {
-            case SMALL:
-                loop_small();
-                break;
-            case BIG:
-                loop_big();
-                break;
-            default:
-                loop_small();
-        }
+        // run the tasks due since the last spin
+        SCHEDULER_Run();
+
+        // latch whatever the tasks changed at the next PWM period
+        OUTPUT_Commit();
+
+        // nothing left until the next interrupt
+        idle();
     }
 }
 
 void setPWMValues(uint16_t dutyValue, const PwmChannel_t pwmMode) {
+    fadePWMValues(dutyValue, pwmMode, 0);
+}
+
+/**
+ * Crossfade to one channel or all of them at a brightness
+ * @param ticks fade time, 0 switches at once
+ */
+void fadePWMValues(uint16_t dutyValue, const PwmChannel_t pwmMode, uint16_t ticks) {
+    uint16_t level = GAMMA_LEVEL(dutyValue);
+
     switch(pwmMode) {
         case ALL:
-            PWM1_LoadDutyValue(dutyValue);
-            PWM2_LoadDutyValue(dutyValue);
-            PWM5_LoadDutyValue(dutyValue);
-            PWM6_LoadDutyValue(dutyValue);
+            FADE_To(level, level, level, level, ticks);
             break;
         case PWM1:
-            PWM1_LoadDutyValue(dutyValue);
-            PWM2_LoadDutyValue(0);
-            PWM5_LoadDutyValue(0);
-            PWM6_LoadDutyValue(0);
+            FADE_To(0, level, 0, 0, ticks);
             break;
         case PWM2:
-            PWM1_LoadDutyValue(0);
-            PWM2_LoadDutyValue(dutyValue);
-            PWM5_LoadDutyValue(0);
-            PWM6_LoadDutyValue(0);
+            FADE_To(level, 0, 0, 0, ticks);
             break;
         case PWM5:
-            PWM1_LoadDutyValue(0);
-            PWM2_LoadDutyValue(0);
-            PWM5_LoadDutyValue(dutyValue);
-            PWM6_LoadDutyValue(0);
+            FADE_To(0, 0, level, 0, ticks);
             break;
         case PWM6:
-            PWM1_LoadDutyValue(0);
-            PWM2_LoadDutyValue(0);
-            PWM5_LoadDutyValue(0);
-            PWM6_LoadDutyValue(dutyValue);
+            FADE_To(0, 0, 0, level, ticks);
             break;
         default:
-            PWM1_LoadDutyValue(dutyValue);
-            PWM2_LoadDutyValue(dutyValue);
-            PWM5_LoadDutyValue(dutyValue);
-            PWM6_LoadDutyValue(dutyValue);
+            FADE_To(level, level, level, level, ticks);
     }
 }
 
+/**
+ * Crossfade to a colour, see COLOUR_HsvToLevels()
+ * @param ticks fade time, 0 switches at once
+ */
+void fadeToColour(uint16_t hue, uint8_t saturation, uint8_t value, uint16_t ticks) {
+    uint16_t levels[OUTPUT_CHANNEL_COUNT];
+
+    COLOUR_HsvToLevels(hue, saturation, value, levels);
+    FADE_To(levels[OUTPUT_RED], levels[OUTPUT_GREEN], levels[OUTPUT_BLUE], levels[OUTPUT_WHITE], ticks);
+}
+
+/**
+ * Walk the colour wheel, called on every tick
+ */
+void rainbow(void) {
+    static uint16_t hue = COLOUR_HUE_RED;
+
+    fadeToColour(hue, RAINBOW_SATURATION, RAINBOW_BRIGHTNESS, 0);
+    hue += RAINBOW_HUE_STEP;
+}
+
+/**
+ * Random color step, called on every tick. Picks a new color every
+ * randomInterval ticks and crossfades to it in randomFadeTicks.
+ */
 void random(void) {
-    uint16_t maxValue = 40;
-    setPWMValues(rand() % maxValue, rand() % 5); // 0-39
-   __delay_ms(1000);
+    static uint16_t delay = 0;
+
+    if(delay) {
+        --delay;
+        return;
+    }
+    delay = randomInterval ? randomInterval - 1 : 0;
+
+    fadePWMValues(PRNG_Below(RANDOM_BRIGHTNESS_COUNT), (PwmChannel_t)PRNG_Below(PWM6 + 1), randomFadeTicks);
 }
 
+/**
+ * Ramp one channel up and down then move to the next one.
+ * Step function called on every tick, advances every BLINKING_STEP_TICKS.
+ */
 void blinking(void) {
     static uint16_t dutyCycleMin = 0;
     static uint16_t dutyCycleMax = 128;
+    static uint16_t dutyCycle = 0;
+    static bool rising = true;
     static char pwmID = 1;
+    static uint8_t delay = 0;
 
-    for(uint16_t dutyCycle = dutyCycleMin; dutyCycle < dutyCycleMax; dutyCycle++) {
-        setPWMValues(dutyCycle, pwmID);
-        __delay_ms(10);
+    if(delay) {
+        --delay;
+        return;
     }
+    delay = BLINKING_STEP_TICKS - 1;
 
-    for(uint16_t dutyCycle = dutyCycleMax; dutyCycle > dutyCycleMin; dutyCycle--) {
-        setPWMValues(dutyCycle, pwmID);
-        __delay_ms(10);
-    }
+    setPWMValues(dutyCycle, pwmID);
 
-    if(++pwmID > 4) {
-        pwmID = 1;
+    if(rising) {
+        if(++dutyCycle >= dutyCycleMax) {
+            rising = false;
+        }
+    } else if(--dutyCycle <= dutyCycleMin) {
+        rising = true;
+        if(++pwmID > 4) {
+            pwmID = 1;
+        }
     }
 }
 
-// small panel
-void loop_small(void) {
-    switch(state) {
-    case 0: // initialize state
-        setPWMValues(0x00, ALL); //Switch off
-        state = 1;
-        break;
-                                   //--+--------------------------------+
-                                   //  |      SMALL     |      BIG      |
-                                   //--+----------------+---------------+
-    case 1:                        //  |                |               |
-        PWM2_LoadDutyValue(2);     // R|   255 - 3.67V  |  255 - 3.22V  |
-        PWM1_LoadDutyValue(2);     // G|   255 - 2.40V  |  255 - 1.89V  |
-        PWM5_LoadDutyValue(2);     // B|   255 - 1.97V  |  255 - 1.46V  |
-        PWM6_LoadDutyValue(2);     // W|   255 - 1.10V  |  255 - 1.08V  |
-        break;                     //  |                |               |
-    case 2:                        //--+----------------+---------------+
-        PWM2_LoadDutyValue(18);    // R|    18 - 0.27V  |   18 - 0.25V  |
-        PWM1_LoadDutyValue(21);    // G|    21 - 0.18V  |   21 - 0.15V  |
-        PWM5_LoadDutyValue(14);    // B|    14 - 0.1V   |   14 - 0.08V  |
-        PWM6_LoadDutyValue(19);    // W|    19 - 0.07V  |   19 - 0.06V  |
-        break;                     //--+----------------+---------------+
-    case 3:                        //  |                |               |
-        PWM2_LoadDutyValue(38);    // R|    38 - 0.55V  |   38 - 0.49V  |
-        PWM1_LoadDutyValue(43);    // G|    43 - 0.37V  |   43 - 0.30V  |
-        PWM5_LoadDutyValue(26);    // B|    26 - 0.19V  |   26 - 0.15V  |
-        PWM6_LoadDutyValue(38);    // W|    38 - 0.14V  |   38 - 0.11V  |
-        break;                     //--+----------------+---------------+
-    case 4:                        //  |                |               |
-        PWM2_LoadDutyValue(85);    // R|    85 - 1.2V   |   85 - 1.02V  |
-        PWM1_LoadDutyValue(86);    // G|    86 - 0.74V  |   86 - 0.54V  |
-        PWM5_LoadDutyValue(54);    // B|    54 - 0.39V  |   54 - 0.29V  |
-        PWM6_LoadDutyValue(75);    // W|    75 - 0.29V  |   75 - 0.19V  |
-        break;                     //--+----------------+---------------+
-    case 5:                        //  |                |               |
-        PWM2_LoadDutyValue(131);   // R|   131 - 1.86V  |  131 - 1.58V  |
-        PWM1_LoadDutyValue(131);   // G|   131 - 1.15V  |  131 - 0.86V  |
-        PWM5_LoadDutyValue(83);    // B|   83  - 0.6V   |   83 - 0.43V  |
-        PWM6_LoadDutyValue(113);   // W|   113 - 0.44V  |  113 - 0.29V  |
-        break;                     //--+----------------+---------------+
-    case 6:                        //  |                |               |
-        PWM2_LoadDutyValue(182);   // R|   182 - 2.61V  |  182 - 2.27V  |
-        PWM1_LoadDutyValue(174);   // G|   174 - 1.6V   |  174 - 1.22V  |
-        PWM5_LoadDutyValue(110);   // B|   110 - 0.82V  |  110 - 0.59V  |
-        PWM6_LoadDutyValue(150);   // W|   150 - 0.62V  |  150 - 0.42V  |
-        break;                     //--+----------------+---------------+
-    case 7:                        //  |                |               |
-        PWM2_LoadDutyValue(225);   // R|   225 - 3.28V  |  225 - 2.92V  |
-        PWM1_LoadDutyValue(214);   // G|   214 - 2.06V  |  214 - 1.6V   |
-        PWM5_LoadDutyValue(138);   // B|   138 - 1.05V  |  138 - 0.74V  |
-        PWM6_LoadDutyValue(188);   // W|   188 - 0.8V   |  188 - 0.58V  |
-        break;                     //--+----------------+---------------+
-    default:
-        setPWMValues(0x00, ALL);   //Switch off
-        state = 0;
+// preset levels of the selected panel, rendered only when the state or the panel changes
+void loop_panel(void) {
+    static uint8_t renderedState;
+    static PanelType_t renderedPanel;
+
+    // a ramp owns the outputs, at night they stay where it left them
+    if(night || RAMP_IsActive()) {
+        return;
     }
-}
 
-// big panel
-void loop_big(void) {
-    switch(state) {
-    case 0: // initialize state
-        setPWMValues(0x00, ALL); //Switch off
-        state = 1;
-        break;
-                                   //--+--------------------------------+--------------+
-                                   //  |      SMALL     |      BIG      |  MANUAL BIG  |
-                                   //--+----------------+---------------+--------------+
-    case 1:                        //  |                |               |              |
-        PWM2_LoadDutyValue(2);     // R|   255 - 3.67V  |  255 - 3.24V  |              |
-        PWM1_LoadDutyValue(2);     // G|   255 - 2.40V  |  255 - 1.92V  |              |
-        PWM5_LoadDutyValue(2);     // B|   255 - 1.97V  |  255 - 1.46V  |              |
-        PWM6_LoadDutyValue(2);     // W|   255 - 1.10V  |  255 - 1.08V  |              |
-        break;                     //  |                |               |              |
-    case 2:                        //--+----------------+---------------+--------------+
-        PWM2_LoadDutyValue(20);    // R|    18 - 0.27V  |   18 - 0.25V  |   20 - 0.27V |
-        PWM1_LoadDutyValue(25);    // G|    21 - 0.18V  |   21 - 0.15V  |   25 - 0.18V |
-        PWM5_LoadDutyValue(17);    // B|    14 - 0.1V   |   14 - 0.08V  |   17 - 0.1V  |
-        PWM6_LoadDutyValue(22);    // W|    19 - 0.07V  |   19 - 0.06V  |   22 - 0.07V |
-        break;                     //--+----------------+---------------+--------------+
-    case 3:                        //  |                |               |              |
-        PWM2_LoadDutyValue(43);    // R|    38 - 0.55V  |   38 - 0.49V  |   43 - 0.56V |
-        PWM1_LoadDutyValue(51);    // G|    43 - 0.37V  |   43 - 0.30V  |   51 - 0.37V |
-        PWM5_LoadDutyValue(31);    // B|    26 - 0.19V  |   26 - 0.15V  |   31 - 0.18V |
-        PWM6_LoadDutyValue(43);    // W|    38 - 0.14V  |   38 - 0.11V  |   43 - 0.13V |
-        break;                     //--+----------------+---------------+--------------+
-    case 4:                        //  |                |               |              |
-        PWM2_LoadDutyValue(98);    // R|    85 - 1.2V   |   85 - 1.02V  |   98 - 1.21V |
-        PWM1_LoadDutyValue(107);   // G|    86 - 0.74V  |   86 - 0.54V  |  107 - 0.74V |
-        PWM5_LoadDutyValue(69);    // B|    54 - 0.39V  |   54 - 0.29V  |   69 - 0.39V |
-        PWM6_LoadDutyValue(105);   // W|    75 - 0.29V  |   75 - 0.19V  |  105 - 0.29V |
-        break;                     //--+----------------+---------------+--------------+
-    case 5:                        //  |                |               |              |
-        PWM2_LoadDutyValue(150);   // R|   131 - 1.86V  |  131 - 1.58V  |  150 - 1.84V |
-        PWM1_LoadDutyValue(162);   // G|   131 - 1.15V  |  131 - 0.86V  |  162 - 1.15V |
-        PWM5_LoadDutyValue(110);   // B|   83  - 0.6V   |   83 - 0.43V  |  110 - 0.6V  |
-        PWM6_LoadDutyValue(151);   // W|   113 - 0.44V  |  113 - 0.29V  |  151 - 0.44V |
-        break;                     //--+----------------+---------------+--------------+
-    case 6:                        //  |                |               |              |
-        PWM2_LoadDutyValue(206);   // R|   182 - 2.61V  |  182 - 2.27V  |  206 - 2.6V  |
-        PWM1_LoadDutyValue(216);   // G|   174 - 1.6V   |  174 - 1.22V  |  216 - 1.59V |
-        PWM5_LoadDutyValue(146);   // B|   110 - 0.82V  |  110 - 0.59V  |  146 - 0.8V  |
-        PWM6_LoadDutyValue(196);   // W|   150 - 0.62V  |  150 - 0.42V  |  196 - 0.6V  |
-        break;                     //--+----------------+---------------+--------------+
-    case 7:                        //  |                |               |              |
-        PWM2_LoadDutyValue(255);   // R|   225 - 3.28V  |  225 - 2.92V  |  255 - 3.24V |
-        PWM1_LoadDutyValue(255);   // G|   214 - 2.06V  |  214 - 1.6V   |  255 - 1.92V |
-        PWM5_LoadDutyValue(183);   // B|   138 - 1.05V  |  138 - 0.74V  |  183 - 1.03V |
-        PWM6_LoadDutyValue(245);   // W|   188 - 0.8V   |  210 - 0.58V  |  245 - 0.78V |
-        break;                     //--+----------------+---------------+--------------+
-    default:
-        setPWMValues(0x00, ALL);   //Switch off
+    if(panelRendered && state == renderedState && panelType == renderedPanel) {
+        return;
+    }
+    panelRendered = true;
+    renderedState = state;
+    renderedPanel = panelType;
+
+    if(state == 0) {
+        // initialize state
+        FADE_To(0, 0, 0, 0, FADE_DEFAULT_TICKS); //Switch off
+        state = STATE_LEVEL_MIN;
+    } else if(state > STATE_LEVEL_MAX) {
+        FADE_To(0, 0, 0, 0, FADE_DEFAULT_TICKS); //Switch off
         state = 0;
+    } else {
+        PRESET_Render(panelType, state, FADE_DEFAULT_TICKS);
     }
 }
 
+// the weather clears up for the night, the moonlight stays calm
+void loop_weather(void) {
+    WEATHER_Task(night ? WEATHER_CLEAR : weatherMode);
+}
+
+// the effects in turn, one per state, see demo.h
 void loop_for_demo(void) {
     switch(state) {
         case 0: // initialize state
             setPWMValues(0x00, ALL); //Switch off
-            state = 1;
+            state = DEMO_STATE_RANDOM;
             break;
-        case 1: // random led
+        case DEMO_STATE_RANDOM:
             random();
             break;
-        case 2: // blinking led
+        case DEMO_STATE_BLINKING:
             blinking();
             break;
         case 3:
@@ -310,22 +440,108 @@ void loop_for_demo(void) {
         case 6:
             setPWMValues(0x00FF, PWM6);
             break;
+        case DEMO_STATE_RAINBOW:
+            rainbow();
+            break;
         default:
             setPWMValues(0x00, ALL); //Switch off
             state = 0;
     }
 }
 
-bool ButtonChangeCheck(void) {
-    if(!Button_GetValue()) {
-        //button is active low
-        __delay_ms(10); //wait for prell
-        while(!Button_GetValue())
-            ; //wait until release
-        __delay_ms(10); //wait for prell
-        return true; // button pressed
+bool ButtonCommand(ButtonEvent_t event) {
+    // nothing is less predictable than the tick of a press
+    PRNG_Stir(SCHEDULER_GetTicks());
+
+    if(event == BUTTON_EVENT_LONG_PRESS) {
+        // reverses a running ramp from where it is
+        if(night) {
+            sunrise();
+        } else {
+            sunset();
+        }
+        return false;
+    }
+
+    if(night || RAMP_IsActive()) {
+        // any other gesture ends the ramp or the night, back to the state level
+        RAMP_Stop();
+        night = false;
+        panelRendered = false;
+        return false;
+    }
+
+    switch(event) {
+        case BUTTON_EVENT_SHORT_PRESS:
+            ++state;
+            return true;
+        case BUTTON_EVENT_DOUBLE_PRESS:
+            state = STATE_LEVEL_MAX;
+            return true;
+        default:
+            return false;
+    }
+}
+
+void sunrise(void) {
+    if(state < STATE_LEVEL_MIN || state > STATE_LEVEL_MAX) {
+        state = STATE_LEVEL_MIN;
+    }
+    night = false;
+    lightTo(PRESET_GetBrightness(panelType, state), RAMP_DEFAULT_MINUTES);
+
+    // the state machine takes over again once the ramp is done
+    panelRendered = false;
+}
+
+void sunset(void) {
+    moonlight(RAMP_DEFAULT_MINUTES);
+}
+
+void moonlight(uint8_t rampMinutes) {
+    uint16_t levels[OUTPUT_CHANNEL_COUNT];
+
+    // tonight's moon, the preset is the full one
+    MOON_GetLevels(presetMoonlight, levels);
+    night = true;
+    lightToLevels(levels, rampMinutes);
+}
+
+void lightTo(const uint8_t *brightness, uint8_t rampMinutes) {
+    uint16_t levels[OUTPUT_CHANNEL_COUNT] = { 0, 0, 0, 0 };
+
+    if(brightness != NULL) {
+        for(uint8_t i = 0; i < OUTPUT_CHANNEL_COUNT; i++) {
+            levels[i] = GAMMA_LEVEL(brightness[i]);
+        }
+    }
+    lightToLevels(levels, rampMinutes);
+}
+
+void lightToLevels(const uint16_t *levels, uint8_t rampMinutes) {
+    // either one replaces a running fade or ramp
+    if(rampMinutes) {
+        RAMP_To(levels[OUTPUT_RED], levels[OUTPUT_GREEN], levels[OUTPUT_BLUE], levels[OUTPUT_WHITE],
+                RAMP_MINUTES_TO_STEPS(rampMinutes));
+    } else {
+        FADE_To(levels[OUTPUT_RED], levels[OUTPUT_GREEN], levels[OUTPUT_BLUE], levels[OUTPUT_WHITE],
+                FADE_DEFAULT_TICKS);
+    }
+}
+
+void photoperiodEvent(uint8_t level, uint8_t rampMinutes) {
+    if(level == PHOTOPERIOD_LEVEL_OFF) {
+        night = true;
+        lightTo(NULL, rampMinutes);
+    } else if(level == PHOTOPERIOD_LEVEL_MOONLIGHT) {
+        moonlight(rampMinutes);
+    } else if(level >= STATE_LEVEL_MIN && level <= STATE_LEVEL_MAX) {
+        // program levels are not saved, the journal keeps the manual one
+        state = level;
+        night = false;
+        lightTo(PRESET_GetBrightness(panelType, state), rampMinutes);
+        panelRendered = false;
     }
-    return false;
 }
 
 /**
@@ -0,0 +1,60 @@
+/**
+  Generated Interrupt Manager Source File
+
+  @Company:
+    Microchip Technology Inc.
+
+  @File Name:
+    interrupt_manager.c
+
+  @Summary:
+    This is the Interrupt Manager file generated using PIC10 / PIC12 / PIC16 / PIC18 MCUs
+
+  @Description:
+    This header file provides implementations for global interrupt handling.
+    For individual peripheral handlers please see the peripheral driver for
+    all modules selected in the GUI.
+    Generation Information :
+        Product Revision  :  PIC10 / PIC12 / PIC16 / PIC18 MCUs - 1.65.2
+        Device            :  PIC16F18313
+        Driver Version    :  2.03
+    The generated drivers are tested against the following:
+        Compiler          :  XC8 1.45 or later
+        MPLAB             :  MPLAB X 4.15
+*/
+
+
+
+#include "interrupt_manager.h"
+#include "mcc.h"
+
+void __interrupt() INTERRUPT_InterruptManager (void)
+{
+    // interrupt handler
+    if(PIE0bits.IOCIE == 1 && PIR0bits.IOCIF == 1)
+    {
+        PIN_MANAGER_IOC();
+    }
+    else if(INTCONbits.PEIE == 1)
+    {
+        if(PIE1bits.TMR2IE == 1 && PIR1bits.TMR2IF == 1)
+        {
+            TMR2_ISR();
+        }
+        else if(PIE2bits.NVMIE == 1 && PIR2bits.NVMIF == 1)
+        {
+            NVM_ISR();
+        }
+        else
+        {
+            //Unhandled Interrupt
+        }
+    }
+    else
+    {
+        //Unhandled Interrupt
+    }
+}
+/**
+ End of File
+*/
@@ -81,18 +81,19 @@ void WDT_Initialize(void)
 
 void PMD_Initialize(void)
 {
-    // CLKRMD CLKR enabled; SYSCMD SYSCLK enabled; FVRMD FVR enabled; IOCMD IOC enabled; NVMMD NVM enabled;
-    PMD0 = 0x00;
-    // TMR0MD TMR0 enabled; TMR1MD TMR1 enabled; TMR2MD TMR2 enabled; NCOMD DDS(NCO) enabled;
-    PMD1 = 0x00;
-    // DACMD DAC enabled; CMP1MD CMP1 enabled; ADCMD ADC enabled;
-    PMD2 = 0x00;
-    // CCP2MD CCP2 enabled; CCP1MD CCP1 enabled; PWM6MD PWM6 enabled; PWM5MD PWM5 enabled; CWG1MD CWG1 enabled;
-    PMD3 = 0x00;
-    // MSSP1MD MSSP1 enabled; UART1MD EUSART enabled;
-    PMD4 = 0x00;
-    // DSMMD DSM enabled; CLC1MD CLC1 enabled; CLC2MD CLC2 enabled;
-    PMD5 = 0x00;
+    // only IOC, NVM, TMR2, CCP1/2 and PWM5/6 are used, everything else is gated off
+    // CLKRMD CLKR disabled; SYSCMD SYSCLK enabled; FVRMD FVR disabled; IOCMD IOC enabled; NVMMD NVM enabled;
+    PMD0 = 0x42;
+    // TMR0MD TMR0 disabled; TMR1MD TMR1 disabled; TMR2MD TMR2 enabled; NCOMD DDS(NCO) disabled;
+    PMD1 = 0x83;
+    // DACMD DAC disabled; CMP1MD CMP1 disabled; ADCMD ADC disabled;
+    PMD2 = 0x62;
+    // CCP2MD CCP2 enabled; CCP1MD CCP1 enabled; PWM6MD PWM6 enabled; PWM5MD PWM5 enabled; CWG1MD CWG1 disabled;
+    PMD3 = 0x40;
+    // MSSP1MD MSSP1 disabled; UART1MD EUSART disabled;
+    PMD4 = 0x22;
+    // DSMMD DSM disabled; CLC1MD CLC1 disabled; CLC2MD CLC2 disabled;
+    PMD5 = 0x07;
 }
 /**
  End of File
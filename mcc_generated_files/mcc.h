@@ -57,6 +57,7 @@
 #include "pwm6.h"
 #include "tmr2.h"
 #include "pwm5.h"
+#include "interrupt_manager.h"
 
 
 
@@ -110,6 +111,19 @@ void WDT_Initialize(void);
  */
 void PMD_Initialize(void);
 
+/**
+ * @Description
+    Clock the NVM module, before any DATAEE_ or FLASH_ access.
+    Its registers are reset while it is gated off.
+ */
+#define PMD_NVMEnable()     (PMD0bits.NVMMD = 0)
+
+/**
+ * @Description
+    Gate the NVM module off once no access is in progress
+ */
+#define PMD_NVMDisable()    (PMD0bits.NVMMD = 1)
+
 #endif	/* MCC_H */
 /**
  End of File
@@ -51,6 +51,8 @@
 #include <xc.h>
 #include "memory.h"
 
+void (*NVM_InterruptHandler)(void);
+
 /**
   Section: Flash Module APIs
 */
@@ -199,6 +201,29 @@ void DATAEE_WriteByte(uint16_t bAdd, uint8_t bData)
     INTCONbits.GIE = GIEBitValue;   // restore interrupt enable
 }
 
+void DATAEE_StartWriteByte(uint16_t bAdd, uint8_t bData)
+{
+    uint8_t GIEBitValue = INTCONbits.GIE;
+
+    NVMADRH = ((bAdd >> 8) & 0xFF);
+    NVMADRL = (bAdd & 0xFF);
+    NVMDATL = bData;
+    NVMCON1bits.NVMREGS = 1;
+    NVMCON1bits.WREN = 1;
+    PIR2bits.NVMIF = 0;
+    PIE2bits.NVMIE = 1;     // NVM_ISR() runs when the write completes
+    INTCONbits.GIE = 0;     // Disable interrupts for the unlock sequence only
+    NVMCON2 = 0x55;
+    NVMCON2 = 0xAA;
+    NVMCON1bits.WR = 1;
+    INTCONbits.GIE = GIEBitValue;   // restore interrupt enable
+}
+
+bool DATAEE_IsWriteBusy(void)
+{
+    return NVMCON1bits.WR;
+}
+
 uint8_t DATAEE_ReadByte(uint16_t bAdd)
 {
     NVMADRH = ((bAdd >> 8) & 0xFF);
@@ -212,6 +237,30 @@ uint8_t DATAEE_ReadByte(uint16_t bAdd)
 }
 
 
+void NVM_ISR(void)
+{
+    // write completed
+    PIR2bits.NVMIF = 0;
+    PIE2bits.NVMIE = 0;
+    NVMCON1bits.WREN = 0;
+
+    if(NVM_InterruptHandler)
+    {
+        NVM_InterruptHandler();
+    }
+}
+
+void NVM_SetInterruptHandler(void (* InterruptHandler)(void))
+{
+    NVM_InterruptHandler = InterruptHandler;
+}
+
+void NVM_DefaultInterruptHandler(void)
+{
+    // add your NVM interrupt custom code
+    // or set custom function using NVM_SetInterruptHandler()
+}
+
 /**
  End of File
 */
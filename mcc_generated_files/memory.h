@@ -247,6 +247,99 @@ void DATAEE_WriteByte(uint16_t bAdd, uint8_t bData);
 */
 uint8_t DATAEE_ReadByte(uint16_t bAdd);
 
+/**
+  @Summary
+    Starts a data byte write to Data EEPROM
+
+  @Description
+    This routine starts writing a data byte to given Data EEPROM location
+    and returns without waiting. Interrupts are only disabled for the
+    unlock sequence. NVM_ISR() runs when the write has completed.
+
+  @Preconditions
+    No write in progress, see DATAEE_IsWriteBusy().
+    Peripheral and global interrupts enabled for the completion interrupt.
+
+  @Param
+    bAdd  - Data EEPROM location to which data to be written
+    bData - Data to be written to Data EEPROM location
+
+  @Returns
+    None
+
+  @Example
+    <code>
+    NVM_SetInterruptHandler(nextByte);
+    DATAEE_StartWriteByte(0xF010, 0x55);
+    </code>
+*/
+void DATAEE_StartWriteByte(uint16_t bAdd, uint8_t bData);
+
+/**
+  @Summary
+    Checks for a Data EEPROM write in progress
+
+  @Param
+    None
+
+  @Returns
+    true while a write started by DATAEE_StartWriteByte() is running
+*/
+bool DATAEE_IsWriteBusy(void);
+
+/**
+  @Summary
+    NVM write complete Interrupt Service Routine
+
+  @Description
+    Clears the interrupt flag, disables further writes and calls the
+    handler set by NVM_SetInterruptHandler(). The handler may start the
+    next write.
+
+  @Preconditions
+    Called from the interrupt manager only.
+
+  @Param
+    None
+
+  @Returns
+    None
+*/
+void NVM_ISR(void);
+
+/**
+  @Summary
+    Set NVM Interrupt Handler
+
+  @Description
+    This sets the function to be called when a Data EEPROM write completes
+
+  @Param
+    Address of function to be set
+
+  @Returns
+    None
+*/
+void NVM_SetInterruptHandler(void (* InterruptHandler)(void));
+
+/**
+  @Summary
+    NVM Interrupt Handler
+
+  @Description
+    This is a function pointer to the function that will be called from NVM_ISR()
+*/
+extern void (*NVM_InterruptHandler)(void);
+
+/**
+  @Summary
+    Default NVM Interrupt Handler
+
+  @Description
+    This is the default Interrupt Handler function
+*/
+void NVM_DefaultInterruptHandler(void);
+
 
 #ifdef __cplusplus  // Provide C++ Compatibility
 
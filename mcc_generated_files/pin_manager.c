@@ -50,6 +50,8 @@
 #include "pin_manager.h"
 #include "stdbool.h"
 
+void (*IOCAF5_InterruptHandler)(void);
+
 void PIN_MANAGER_Initialize(void)
 {
     /**
@@ -82,6 +84,22 @@ void PIN_MANAGER_Initialize(void)
     */
     SLRCONA = 0x37;
 
+    /**
+    IOCx registers
+    */
+    //interrupt on change for group IOCAF - flag
+    IOCAFbits.IOCAF5 = 0;
+    //interrupt on change for group IOCAN - negative
+    IOCANbits.IOCAN5 = 1;
+    //interrupt on change for group IOCAP - positive
+    IOCAPbits.IOCAP5 = 1;
+
+    // register default IOC callback functions at runtime; use these methods to register a custom function
+    IOCAF5_SetInterruptHandler(IOCAF5_DefaultInterruptHandler);
+
+    // Enable IOCI interrupt
+    PIE0bits.IOCIE = 1;
+
     RA4PPS = 0x03;   //RA4->PWM6:PWM6;
     RA1PPS = 0x0D;   //RA1->CCP2:CCP2;
     RA2PPS = 0x02;   //RA2->PWM5:PWM5;
@@ -90,6 +108,41 @@ void PIN_MANAGER_Initialize(void)
 
 void PIN_MANAGER_IOC(void)
 {
+    // interrupt on change for pin IOCAF5
+    if(IOCAFbits.IOCAF5 == 1)
+    {
+        IOCAF5_ISR();
+    }
+}
+
+/**
+   IOCAF5 Interrupt Service Routine
+*/
+void IOCAF5_ISR(void) {
+
+    // Add custom IOCAF5 code
+
+    // Call the interrupt handler for the callback registered at runtime
+    if(IOCAF5_InterruptHandler)
+    {
+        IOCAF5_InterruptHandler();
+    }
+    IOCAFbits.IOCAF5 = 0;
+}
+
+/**
+  Allows selecting an interrupt handler for IOCAF5 at application runtime
+*/
+void IOCAF5_SetInterruptHandler(void (* InterruptHandler)(void)){
+    IOCAF5_InterruptHandler = InterruptHandler;
+}
+
+/**
+  Default interrupt handler for IOCAF5
+*/
+void IOCAF5_DefaultInterruptHandler(void){
+    // add your IOCAF5 interrupt custom code
+    // or set custom function using IOCAF5_SetInterruptHandler()
 }
 
 /**
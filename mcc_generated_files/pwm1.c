@@ -50,6 +50,7 @@
 
 #include <xc.h>
 #include "pwm1.h"
+#include "tmr2.h"
 
 /**
   Section: Macro Declarations
@@ -77,8 +78,15 @@ void PWM1_Initialize(void)
 
 void PWM1_LoadDutyValue(uint16_t dutyValue)
 {
-    CCPR1H = dutyValue * PR2 / 0xFF;
-    CCPR1L = 0x0FF;
+    // scale 0..255 to the 10 bit duty of the 0..PR2 period without a division, see TMR2_DutyScale
+    PWM1_LoadDuty10((dutyValue * TMR2_DutyScale) >> 6);
+}
+
+void PWM1_LoadDuty10(uint16_t dutyValue)
+{
+    // left aligned: 8 MSBs in CCPR1H, 2 LSBs in CCPR1L<7:6>
+    CCPR1H = (uint8_t)(dutyValue >> 2);
+    CCPR1L = (uint8_t)(dutyValue << 6);
 }
 
 bool PWM1_OutputStatusGet(void)
@@ -98,10 +98,11 @@ void PWM1_Initialize(void);
 
 /**
   @Summary
-    Loads 16-bit duty cycle.
+    Loads 8-bit duty cycle scaled to the timer period.
 
   @Description
-    This routine loads the 16 bit duty cycle value.
+    This routine scales the 0..255 duty cycle value to the TMR2 period
+    (PR2) and loads it with the full 10 bit resolution.
 
   @Preconditions
     PWM1_Initialize() function should have been called
@@ -123,6 +124,33 @@ void PWM1_Initialize(void);
 */
 void PWM1_LoadDutyValue(uint16_t dutyValue);
 
+/**
+  @Summary
+    Loads the full 10-bit duty cycle.
+
+  @Description
+    This routine loads the 10 bit duty cycle value into the duty cycle
+    registers, including the two low bits. Full scale is 4 * (PR2 + 1),
+    i.e. TMR2_DutyScale << 2 (768 steps with PR2 191).
+
+  @Preconditions
+    PWM1_Initialize() function should have been called
+    before calling this function.
+
+  @Param
+    Pass 10bit duty cycle value.
+
+  @Returns
+    None
+
+  @Example
+    <code>
+    PWM1_Initialize();
+    PWM1_LoadDuty10(TMR2_DutyScale << 1); // 50%
+    </code>
+*/
+void PWM1_LoadDuty10(uint16_t dutyValue);
+
 /**
   @Summary
     Read pwm output status.
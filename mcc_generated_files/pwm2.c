@@ -50,6 +50,7 @@
 
 #include <xc.h>
 #include "pwm2.h"
+#include "tmr2.h"
 
 /**
   Section: Macro Declarations
@@ -77,8 +78,15 @@ void PWM2_Initialize(void)
 
 void PWM2_LoadDutyValue(uint16_t dutyValue)
 {
-    CCPR2H = dutyValue * PR2 / 0xFF;
-    CCPR2L = 0x0FF;
+    // scale 0..255 to the 10 bit duty of the 0..PR2 period without a division, see TMR2_DutyScale
+    PWM2_LoadDuty10((dutyValue * TMR2_DutyScale) >> 6);
+}
+
+void PWM2_LoadDuty10(uint16_t dutyValue)
+{
+    // left aligned: 8 MSBs in CCPR2H, 2 LSBs in CCPR2L<7:6>
+    CCPR2H = (uint8_t)(dutyValue >> 2);
+    CCPR2L = (uint8_t)(dutyValue << 6);
 }
 
 bool PWM2_OutputStatusGet(void)
@@ -50,6 +50,7 @@
 
  #include <xc.h>
  #include "pwm5.h"
+ #include "tmr2.h"
 
  /**
    Section: PWM Module APIs
@@ -61,20 +62,25 @@
     // PWM5POL active_hi; PWM5EN enabled;
     PWM5CON = 0x80;
 
-    // PWM5DCH 127;
-    PWM5DCH = 0x7F;
+    // PWM5DCH 0;
+    PWM5DCH = 0x00;
 
-    // PWM5DCL 3;
-    PWM5DCL = 0xC0;
+    // PWM5DCL 0;
+    PWM5DCL = 0x00;
  }
 
  void PWM5_LoadDutyValue(uint16_t dutyValue)
  {
-     // Writing to 8 MSBs of PWM duty cycle in PWMDCH register
-     PWM5DCH = dutyValue * PR2 / 0xFF; // (dutyValue & 0x03FC)>>2;
+     // scale 0..255 to the 10 bit duty of the 0..PR2 period without a division, see TMR2_DutyScale
+     PWM5_LoadDuty10((dutyValue * TMR2_DutyScale) >> 6);
+ }
 
+ void PWM5_LoadDuty10(uint16_t dutyValue)
+ {
+     // Writing to 8 MSBs of PWM duty cycle in PWMDCH register
+     PWM5DCH = (uint8_t)((dutyValue & 0x03FC)>>2);
      // Writing to 2 LSBs of PWM duty cycle in PWMDCL register
-     PWM5DCL = 0x00;    // (dutyValue & 0x0003)<<6;
+     PWM5DCL = (uint8_t)((dutyValue & 0x0003)<<6);
  }
  /**
   End of File
@@ -103,10 +103,11 @@
 
  /**
    @Summary
-     Loads 16-bit duty cycle.
+     Loads 8-bit duty cycle scaled to the timer period.
 
    @Description
-     This routine loads the 16 bit duty cycle value.
+     This routine scales the 0..255 duty cycle value to the TMR2 period
+     (PR2) and loads it with the full 10 bit resolution.
 
    @Preconditions
      PWM5_Initialize() function should have been called
@@ -128,6 +129,33 @@
  */
  void PWM5_LoadDutyValue(uint16_t dutyValue);
 
+ /**
+   @Summary
+     Loads the full 10-bit duty cycle.
+
+   @Description
+     This routine loads the 10 bit duty cycle value into the duty cycle
+     registers, including the two low bits. Full scale is 4 * (PR2 + 1),
+     i.e. TMR2_DutyScale << 2 (768 steps with PR2 191).
+
+   @Preconditions
+     PWM5_Initialize() function should have been called
+     before calling this function.
+
+   @Param
+     Pass 10bit duty cycle value.
+
+   @Returns
+     None
+
+   @Example
+     <code>
+     PWM5_Initialize();
+     PWM5_LoadDuty10(TMR2_DutyScale << 1); // 50%
+     </code>
+ */
+ void PWM5_LoadDuty10(uint16_t dutyValue);
+
 
  #ifdef __cplusplus  // Provide C++ Compatibility
 
@@ -50,6 +50,7 @@
 
  #include <xc.h>
  #include "pwm6.h"
+ #include "tmr2.h"
 
  /**
    Section: PWM Module APIs
@@ -61,20 +62,25 @@
     // PWM6POL active_hi; PWM6EN enabled;
     PWM6CON = 0x80;
 
-    // PWM6DCH 127;
-    PWM6DCH = 0x7F;
+    // PWM6DCH 0;
+    PWM6DCH = 0x00;
 
-    // PWM6DCL 3;
-    PWM6DCL = 0xC0;
+    // PWM6DCL 0;
+    PWM6DCL = 0x00;
  }
 
  void PWM6_LoadDutyValue(uint16_t dutyValue)
  {
-     // Writing to 8 MSBs of PWM duty cycle in PWMDCH register
-     PWM6DCH = dutyValue * PR2 / 0xFF; // (dutyValue & 0x03FC)>>2;
+     // scale 0..255 to the 10 bit duty of the 0..PR2 period without a division, see TMR2_DutyScale
+     PWM6_LoadDuty10((dutyValue * TMR2_DutyScale) >> 6);
+ }
 
+ void PWM6_LoadDuty10(uint16_t dutyValue)
+ {
+     // Writing to 8 MSBs of PWM duty cycle in PWMDCH register
+     PWM6DCH = (uint8_t)((dutyValue & 0x03FC)>>2);
      // Writing to 2 LSBs of PWM duty cycle in PWMDCL register
-     PWM6DCL = 0x00; // (dutyValue & 0x0003)<<6;
+     PWM6DCL = (uint8_t)((dutyValue & 0x0003)<<6);
  }
  /**
   End of File
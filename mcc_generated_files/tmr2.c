@@ -55,6 +55,12 @@
   Section: Global Variables Definitions
 */
 
+void (*TMR2_InterruptHandler)(void);
+void (*TMR2_PeriodHandler)(void);
+
+uint16_t TMR2_DutyScale = 0xBF + 1;
+uint8_t TMR2_TickerFactor = TMR2_INTERRUPT_TICKER_FACTOR;
+
 /**
   Section: TMR2 APIs
 */
@@ -65,6 +71,7 @@ void TMR2_Initialize(void)
 
     // PR2 191;
     PR2 = 0xBF;
+    TMR2_DutyScale = 0xBF + 1;
 
     // TMR2 0;
     TMR2 = 0x00;
@@ -72,8 +79,15 @@ void TMR2_Initialize(void)
     // Clearing IF flag.
     PIR1bits.TMR2IF = 0;
 
-    // T2CKPS 1:1; T2OUTPS 1:1; TMR2ON on;
-    T2CON = 0x04;
+    // Enabling TMR2 interrupt.
+    PIE1bits.TMR2IE = 1;
+
+    // Set Default Interrupt Handler
+    TMR2_SetInterruptHandler(TMR2_DefaultInterruptHandler);
+    TMR2_SetPeriodHandler(TMR2_DefaultInterruptHandler);
+
+    // T2CKPS 1:1; T2OUTPS 1:5; TMR2ON on;
+    T2CON = 0x24;
 }
 
 void TMR2_StartTimer(void)
@@ -106,6 +120,7 @@ void TMR2_WriteTimer(uint8_t timerVal)
 void TMR2_LoadPeriodRegister(uint8_t periodVal)
 {
    PR2 = periodVal;
+   TMR2_DutyScale = (uint16_t)periodVal + 1;
 }
 
 bool TMR2_HasOverflowOccured(void)
@@ -119,6 +134,56 @@ bool TMR2_HasOverflowOccured(void)
     }
     return status;
 }
+
+void TMR2_ISR(void)
+{
+    static volatile uint8_t CountCallBack = 0;
+
+    // clear the TMR2 interrupt flag
+    PIR1bits.TMR2IF = 0;
+
+    // period handler - called on every interrupt, right after a period match
+    if(TMR2_PeriodHandler)
+    {
+        TMR2_PeriodHandler();
+    }
+
+    // callback function - called every 25th pass
+    if (++CountCallBack >= TMR2_TickerFactor)
+    {
+        // ticker function call
+        TMR2_CallBack();
+
+        // reset ticker counter
+        CountCallBack = 0;
+    }
+}
+
+void TMR2_CallBack(void)
+{
+    // Add your custom callback code here
+    // this code executes every TMR2_TickerFactor periods of TMR2
+    if(TMR2_InterruptHandler)
+    {
+        TMR2_InterruptHandler();
+    }
+}
+
+void TMR2_SetInterruptHandler(void (* InterruptHandler)(void))
+{
+    TMR2_InterruptHandler = InterruptHandler;
+}
+
+void TMR2_SetPeriodHandler(void (* PeriodHandler)(void))
+{
+    TMR2_PeriodHandler = PeriodHandler;
+}
+
+void TMR2_DefaultInterruptHandler(void)
+{
+    // add your TMR2 interrupt custom code
+    // or set custom function using TMR2_SetInterruptHandler()
+}
 /**
   End of File
 */
\ No newline at end of file
@@ -65,6 +65,30 @@
   Section: Macro Declarations
 */
 
+/**
+  TMR2 postscaled interrupts (1:5, i.e. every 120 us with PR2 191 at 32 MHz)
+  per callback, giving a 3 ms callback period.
+*/
+#define TMR2_INTERRUPT_TICKER_FACTOR    25
+
+/**
+  Section: Global Variables
+*/
+
+/**
+  PWM duty scale, PR2 + 1. Refreshed whenever PR2 is loaded, so the PWM
+  drivers scale a duty with one multiply and a shift instead of a divide:
+  PWMx_LoadDuty10((dutyValue * TMR2_DutyScale) >> 6)
+*/
+extern uint16_t TMR2_DutyScale;
+
+/**
+  Postscaled interrupts per callback, TMR2_INTERRUPT_TICKER_FACTOR after
+  initialization. Changed with the period and postscaler to keep the
+  callback period.
+*/
+extern uint8_t TMR2_TickerFactor;
+
 /**
   Section: TMR2 APIs
 */
@@ -324,6 +348,134 @@ void TMR2_LoadPeriodRegister(uint8_t periodVal);
 */
 bool TMR2_HasOverflowOccured(void);
 
+/**
+  @Summary
+    Timer Interrupt Service Routine
+
+  @Description
+    Timer Interrupt Service Routine is called by the Interrupt Manager.
+
+  @Preconditions
+    Initialize  the TMR2 module with interrupt before calling this ISR.
+
+  @Param
+    None
+
+  @Returns
+    None
+*/
+void TMR2_ISR(void);
+
+/**
+  @Summary
+    CallBack function
+
+  @Description
+    This function is called from the timer ISR. User can write your code in this function.
+
+  @Preconditions
+    Initialize  the TMR2 module with interrupt before calling this function.
+
+  @Param
+    None
+
+  @Returns
+    None
+*/
+void TMR2_CallBack(void);
+
+/**
+  @Summary
+    Set Timer Interrupt Handler
+
+  @Description
+    This sets the function to be called during the ISR
+
+  @Preconditions
+    Initialize  the TMR2 module with interrupt before calling this.
+
+  @Param
+    Address of function to be set
+
+  @Returns
+    None
+*/
+void TMR2_SetInterruptHandler(void (* InterruptHandler)(void));
+
+/**
+  @Summary
+    Set Timer Period Handler
+
+  @Description
+    This sets the function to be called on every TMR2 interrupt, right after
+    the postscaled period match, before the ticker callback. Duty cycle
+    registers written here are latched together at the next period match.
+
+  @Preconditions
+    Initialize  the TMR2 module with interrupt before calling this.
+
+  @Param
+    Address of function to be set
+
+  @Returns
+    None
+*/
+void TMR2_SetPeriodHandler(void (* PeriodHandler)(void));
+
+/**
+  @Summary
+    Timer Period Handler
+
+  @Description
+    This is a function pointer to the function that will be called on every TMR2 interrupt
+
+  @Preconditions
+    Initialize  the TMR2 module with interrupt before calling this isr.
+
+  @Param
+    None
+
+  @Returns
+    None
+*/
+extern void (*TMR2_PeriodHandler)(void);
+
+/**
+  @Summary
+    Timer Interrupt Handler
+
+  @Description
+    This is a function pointer to the function that will be called during the ISR
+
+  @Preconditions
+    Initialize  the TMR2 module with interrupt before calling this isr.
+
+  @Param
+    None
+
+  @Returns
+    None
+*/
+extern void (*TMR2_InterruptHandler)(void);
+
+/**
+  @Summary
+    Default Timer Interrupt Handler
+
+  @Description
+    This is the default Interrupt Handler function
+
+  @Preconditions
+    Initialize  the TMR2 module with interrupt before calling this isr.
+
+  @Param
+    None
+
+  @Returns
+    None
+*/
+void TMR2_DefaultInterruptHandler(void);
+
  #ifdef __cplusplus  // Provide C++ Compatibility
 
     }
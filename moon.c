@@ -0,0 +1,38 @@
+/*
+ * Lunar cycle of the moonlight
+ */
+
+#include "gamma.h"
+#include "rtc.h"
+#include "moon.h"
+
+#define MOON_BOOT_PHASE         ((uint16_t)(MOON_BOOT_AGE_DAYS * MOON_PHASE_PER_DAY))
+
+uint16_t MOON_GetPhase(void)
+{
+    // wraps at the end of every month
+    return (uint16_t)(MOON_BOOT_PHASE + RTC_GetDays() * MOON_PHASE_PER_DAY);
+}
+
+uint8_t MOON_GetIllumination(void)
+{
+    uint8_t phase = (uint8_t)(MOON_GetPhase() >> 8);
+    uint16_t x = phase < 128 ? phase : 256 - phase;
+    uint32_t lit;
+
+    // 3x^2 - 2x^3 of the distance from the new moon, x in Q7, lit in Q8
+    lit = ((uint32_t)x * x * (384 - 2 * x)) >> 13;
+    return lit > 255 ? 255 : (uint8_t)lit;
+}
+
+void MOON_GetLevels(const uint8_t *brightness, uint16_t *levels)
+{
+    uint8_t lit = MOON_GetIllumination();
+
+    for(uint8_t i = 0; i < OUTPUT_CHANNEL_COUNT; i++) {
+        uint16_t full = GAMMA_LEVEL(brightness[i]);
+        uint16_t dark = full >> MOON_NEW_SHIFT;
+
+        levels[i] = dark + (uint16_t)(((uint32_t)(full - dark) * lit) >> 8);
+    }
+}
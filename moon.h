@@ -0,0 +1,55 @@
+/*
+ * Lunar cycle of the moonlight
+ *
+ * The moonlight preset is the full moon; the rest of the month it follows
+ * the lit fraction of the disc down to 1 / 2^MOON_NEW_SHIFT of it at the
+ * new moon. The phase is counted from the RTC day counter in 1/65536 of a
+ * synodic month (29.530589 days), so the month wraps with the 16 bit
+ * arithmetic; it drifts by a day in about 25 years. The lit fraction is a
+ * smoothstep of the distance from the new moon, within 2 % of the cosine
+ * law, and changes at midnight.
+ *
+ * A long press ramps down to the moonlight; so does the photoperiod
+ * program, once its EEPROM image is enabled.
+ *
+ * Levels are worked out in the 16 bit output range, far below the steps
+ * of the 8 bit logical brightness near the bottom; the dither stage of
+ * the output resolves them.
+ */
+
+#ifndef MOON_H
+#define MOON_H
+
+#include <stdint.h>
+#include "output.h"
+
+// phase advance of a day, 65536 / 29.530589, unsigned: half a month of it
+// overflows the 16 bit int of XC8
+#define MOON_PHASE_PER_DAY      2219U
+
+// age of the moon at power-up in days, 0 new moon, 15 full moon
+#ifndef MOON_BOOT_AGE_DAYS
+#define MOON_BOOT_AGE_DAYS      15
+#endif
+
+// new moon brightness, 1 / 2^n of the full moon
+#define MOON_NEW_SHIFT          4
+
+/**
+ * @return phase of the moon today, 0 new moon, 0x8000 full moon
+ */
+uint16_t MOON_GetPhase(void);
+
+/**
+ * @return lit fraction of the disc today, 0..255
+ */
+uint8_t MOON_GetIllumination(void);
+
+/**
+ * Output levels of tonight's moon
+ * @param brightness logical brightness (see gamma.h) of every channel at the full moon
+ * @param levels OUTPUT_CHANNEL_COUNT output levels
+ */
+void MOON_GetLevels(const uint8_t *brightness, uint16_t *levels);
+
+#endif // MOON_H
@@ -0,0 +1,266 @@
+/*
+ * RGBW output stage
+ */
+
+#include "mcc_generated_files/mcc.h"
+#include "output.h"
+
+// requested levels
+static uint16_t levels[OUTPUT_CHANNEL_COUNT];
+
+// 10 bit duty of each channel with OUTPUT_DITHER_BITS fraction, as set by the main loop
+static uint16_t duties[OUTPUT_CHANNEL_COUNT];
+static bool dirty;
+static uint8_t ditherMask = (1 << OUTPUT_CHANNEL_COUNT) - 1;
+
+// PWM timing for the next commit
+static OutputTiming_t timing;
+static bool timingDirty;
+
+// TMR2_DutyScale * gain / 4, a level times this is the duty << (20 - OUTPUT_DITHER_BITS)
+static uint16_t gain = OUTPUT_GAIN_UNITY;
+static uint16_t dutyScale;
+
+// back buffer handed to the ISR, owned by the ISR while commitPending is set
+static uint16_t staged[OUTPUT_CHANNEL_COUNT];
+static uint8_t stagedDitherMask;
+static OutputTiming_t stagedTiming;
+static bool stagedTimingChange;
+static volatile bool commitPending;
+
+// ISR side: committed duty, its fraction, sigma-delta accumulator and the loaded duty
+static uint16_t base[OUTPUT_CHANNEL_COUNT];
+#if OUTPUT_DITHER_BITS
+static uint8_t fraction[OUTPUT_CHANNEL_COUNT];
+static uint8_t accumulator[OUTPUT_CHANNEL_COUNT];
+#endif
+static uint16_t loaded[OUTPUT_CHANNEL_COUNT];
+
+// flashed channels and the period interrupts left, the count is written last
+static volatile uint8_t flashMask;
+static volatile uint8_t flashPeriods;
+
+static void loadDuty(uint8_t channel, uint16_t duty)
+{
+    switch(channel) {
+        case OUTPUT_RED:
+            PWM2_LoadDuty10(duty);
+            break;
+        case OUTPUT_GREEN:
+            PWM1_LoadDuty10(duty);
+            break;
+        case OUTPUT_BLUE:
+            PWM5_LoadDuty10(duty);
+            break;
+        case OUTPUT_WHITE:
+            PWM6_LoadDuty10(duty);
+            break;
+        default:
+            break;
+    }
+}
+
+void OUTPUT_Initialize(void)
+{
+    // the PWM modules start at 0 duty, nothing to load
+    for(uint8_t i = 0; i < OUTPUT_CHANNEL_COUNT; i++) {
+        levels[i] = 0;
+        duties[i] = 0;
+        staged[i] = 0;
+        base[i] = 0;
+#if OUTPUT_DITHER_BITS
+        fraction[i] = 0;
+        accumulator[i] = 0;
+#endif
+        loaded[i] = 0;
+    }
+    dirty = false;
+    timingDirty = false;
+    stagedTimingChange = false;
+    commitPending = false;
+    flashPeriods = 0;
+    gain = OUTPUT_GAIN_UNITY;
+    dutyScale = (uint16_t)(((uint32_t)TMR2_DutyScale * gain) >> 2);
+}
+
+// the top 10 bit code without a fraction, the dither carry would wrap past it
+#define DUTY_MAX                ((uint16_t)0x3FF << OUTPUT_DITHER_BITS)
+
+// 10 bit duty of the current period: level * 4 * (PR2 + 1) * gain / 0x1000000,
+// keeping OUTPUT_DITHER_BITS of the fraction; only binds with PR2 0xFF
+static uint16_t levelToDuty(uint16_t level)
+{
+    uint16_t duty = (uint16_t)(((uint32_t)level * dutyScale) >> (20 - OUTPUT_DITHER_BITS));
+
+    return duty > DUTY_MAX ? DUTY_MAX : duty;
+}
+
+// every duty again after a change of the scale
+static void rescale(void)
+{
+    dutyScale = (uint16_t)(((uint32_t)TMR2_DutyScale * gain) >> 2);
+    for(uint8_t i = 0; i < OUTPUT_CHANNEL_COUNT; i++) {
+        uint16_t duty = levelToDuty(levels[i]);
+
+        if(duty != duties[i]) {
+            duties[i] = duty;
+            dirty = true;
+        }
+    }
+}
+
+void OUTPUT_SetChannel(OutputChannel_t channel, uint16_t level)
+{
+    uint16_t duty;
+
+    if(channel >= OUTPUT_CHANNEL_COUNT) {
+        return;
+    }
+    levels[channel] = level;
+
+    duty = levelToDuty(level);
+    if(duty != duties[channel]) {
+        duties[channel] = duty;
+        dirty = true;
+    }
+}
+
+void OUTPUT_SetRGBW(uint16_t red, uint16_t green, uint16_t blue, uint16_t white)
+{
+    OUTPUT_SetChannel(OUTPUT_RED, red);
+    OUTPUT_SetChannel(OUTPUT_GREEN, green);
+    OUTPUT_SetChannel(OUTPUT_BLUE, blue);
+    OUTPUT_SetChannel(OUTPUT_WHITE, white);
+}
+
+uint16_t OUTPUT_GetChannel(OutputChannel_t channel)
+{
+    return channel < OUTPUT_CHANNEL_COUNT ? levels[channel] : 0;
+}
+
+void OUTPUT_Commit(void)
+{
+    if(!dirty) {
+        return;
+    }
+
+    // hand the whole set over at once, the ISR never sees half of an update
+    PIE1bits.TMR2IE = 0;
+    for(uint8_t i = 0; i < OUTPUT_CHANNEL_COUNT; i++) {
+        staged[i] = duties[i];
+    }
+    stagedDitherMask = ditherMask;
+    if(timingDirty) {
+        stagedTiming = timing;
+        stagedTimingChange = true;
+        timingDirty = false;
+    }
+    commitPending = true;
+    PIE1bits.TMR2IE = 1;
+
+    dirty = false;
+}
+
+void OUTPUT_SetTiming(const OutputTiming_t *newTiming)
+{
+    // every duty is worked out again for the new period and staged with it
+    TMR2_DutyScale = (uint16_t)newTiming->period + 1;
+    rescale();
+    timing = *newTiming;
+    timingDirty = true;
+    dirty = true;
+}
+
+void OUTPUT_SetGain(uint16_t newGain)
+{
+    if(newGain > OUTPUT_GAIN_UNITY) {
+        newGain = OUTPUT_GAIN_UNITY;
+    }
+    if(newGain != gain) {
+        gain = newGain;
+        rescale();
+    }
+}
+
+void OUTPUT_Flash(uint8_t channelMask, uint8_t periods)
+{
+    // single byte writes, the ISR sees the new mask before the count
+    flashPeriods = 0;
+    flashMask = channelMask;
+    flashPeriods = periods;
+}
+
+bool OUTPUT_IsFlashing(void)
+{
+    return flashPeriods != 0;
+}
+
+void OUTPUT_SetDither(uint8_t channelMask)
+{
+    ditherMask = channelMask;
+    dirty = true;
+}
+
+void OUTPUT_PeriodISR(void)
+{
+    uint8_t flashed = 0;
+    uint16_t full = 0;
+
+    // too close to the next period match, a write could straddle it
+    if(TMR2_ReadTimer() > (PR2 >> 1)) {
+        return;
+    }
+
+    if(flashPeriods) {
+        flashPeriods--;
+        flashed = flashMask;
+        // the top 10 bit code, 4 * (PR2 + 1) would not fit with PR2 0xFF
+        full = ((uint16_t)PR2 << 2) | 3;
+    }
+
+    if(commitPending) {
+        for(uint8_t i = 0; i < OUTPUT_CHANNEL_COUNT; i++) {
+            base[i] = staged[i] >> OUTPUT_DITHER_BITS;
+#if OUTPUT_DITHER_BITS
+            fraction[i] = (stagedDitherMask & (1 << i)) ? (uint8_t)(staged[i] & OUTPUT_DITHER_MASK) : 0;
+#endif
+        }
+        commitPending = false;
+    }
+
+    // the duty registers are double buffered by hardware and latched
+    // together at the next period match, only changed ones are written
+    for(uint8_t i = 0; i < OUTPUT_CHANNEL_COUNT; i++) {
+        uint16_t duty = base[i];
+
+#if OUTPUT_DITHER_BITS
+        // first order sigma-delta: one code up for fraction / 2^bits of the updates
+        if(fraction[i]) {
+            accumulator[i] += fraction[i];
+            if(accumulator[i] > OUTPUT_DITHER_MASK) {
+                accumulator[i] &= OUTPUT_DITHER_MASK;
+                duty++;
+            }
+        }
+#endif
+        if(flashed & (1 << i)) {
+            duty = full;
+        }
+        if(duty != loaded[i]) {
+            loaded[i] = duty;
+            loadDuty(i, duty);
+        }
+    }
+
+    if(stagedTimingChange) {
+        // switch the clock and end the running period right away, so the
+        // new period starts at once with the rescaled duties just loaded;
+        // writing T2CON and TMR2 clears the pre- and postscaler
+        OSCCON1 = (OSCCON1 & 0xF0) | stagedTiming.clockDivider;
+        T2CON = stagedTiming.timerControl;
+        PR2 = stagedTiming.period;
+        TMR2 = stagedTiming.period;
+        TMR2_TickerFactor = stagedTiming.tickerFactor;
+        stagedTimingChange = false;
+    }
+}
@@ -0,0 +1,132 @@
+/*
+ * RGBW output stage
+ *
+ * Keeps a shadow copy of every channel and only touches the PWM registers
+ * when the duty actually changes. Channel levels are PR2 independent,
+ * 0..0xFFFF is the fraction of the full PWM period (0x10000 = 100 %).
+ *
+ * Updates are double buffered: OUTPUT_Commit() hands the four duties to
+ * the TMR2 period ISR, which loads all PWMs right after a period match so
+ * the new colour starts on the same period on every channel.
+ *
+ * Levels between two duty codes are dithered: on every period interrupt
+ * a first order sigma-delta modulator per channel picks the code above
+ * for the fraction of the updates, adding OUTPUT_DITHER_BITS of average
+ * resolution where the deep dim levels need it most.
+ *
+ * Overlays act on top of the levels: a gain scales every channel without
+ * touching the levels the fades and ramps work from, and a flash drives
+ * channels at full duty for a number of period interrupts, far finer than
+ * a scheduler tick.
+ */
+
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef enum OutputChannel {
+    OUTPUT_RED   = 0,   // PWM2 (RA1)
+    OUTPUT_GREEN = 1,   // PWM1 (RA0)
+    OUTPUT_BLUE  = 2,   // PWM5 (RA2)
+    OUTPUT_WHITE = 3    // PWM6 (RA4)
+} OutputChannel_t;
+
+#define OUTPUT_CHANNEL_COUNT    4
+
+// extra bits of dithered resolution (0..6), 0 disables the dither stage; the
+// pattern repeats at most every 2^bits period interrupts (120 us each)
+#ifndef OUTPUT_DITHER_BITS
+#define OUTPUT_DITHER_BITS      4
+#endif
+#define OUTPUT_DITHER_MASK      ((1 << OUTPUT_DITHER_BITS) - 1)
+
+// PWM and tick timing, see OUTPUT_SetTiming()
+typedef struct OutputTiming {
+    uint8_t period;         // PR2
+    uint8_t timerControl;   // T2CON: postscaler, TMR2ON, prescaler
+    uint8_t clockDivider;   // OSCCON1 NDIV code of the HFINTOSC divider
+    uint8_t tickerFactor;   // postscaled TMR2 interrupts per scheduler tick
+} OutputTiming_t;
+
+// full scale level
+#define OUTPUT_LEVEL_MAX        0xFFFF
+
+// level of a 0..255 duty value
+#define OUTPUT_LEVEL_FROM_DUTY8(duty)   ((uint16_t)(duty) << 8)
+
+// gain that leaves the levels as they are, see OUTPUT_SetGain()
+#define OUTPUT_GAIN_UNITY       256
+
+/**
+ * Switch every channel off and reset the shadow registers
+ */
+void OUTPUT_Initialize(void);
+
+/**
+ * Set one channel, takes effect on the next OUTPUT_Commit()
+ * @param channel output channel
+ * @param level 0..OUTPUT_LEVEL_MAX
+ */
+void OUTPUT_SetChannel(OutputChannel_t channel, uint16_t level);
+
+/**
+ * Set all four channels
+ */
+void OUTPUT_SetRGBW(uint16_t red, uint16_t green, uint16_t blue, uint16_t white);
+
+/**
+ * @return current level of a channel
+ */
+uint16_t OUTPUT_GetChannel(OutputChannel_t channel);
+
+/**
+ * Hand the changed duties to the period ISR, no-op if nothing changed.
+ * Called once per main loop pass.
+ */
+void OUTPUT_Commit(void);
+
+/**
+ * Change the PWM period, the TMR2 pre- and postscaler, the system clock
+ * divider and the tick factor in one step. The duties of every channel are
+ * rescaled to the new period and latched with it on the next
+ * OUTPUT_Commit(); the running period is cut short by the switch, the
+ * levels stay the same.
+ */
+void OUTPUT_SetTiming(const OutputTiming_t *timing);
+
+/**
+ * Scale every channel, takes effect on the next OUTPUT_Commit(). Costs as
+ * much as setting the four levels, nothing while it stays the same.
+ * @param gain 0..OUTPUT_GAIN_UNITY
+ */
+void OUTPUT_SetGain(uint16_t gain);
+
+/**
+ * Drive channels at full duty for a while, whatever their levels and the
+ * gain. Starts on the next period interrupt without a commit and replaces
+ * a running flash.
+ * @param channelMask bit n set flashes OutputChannel_t n
+ * @param periods period interrupts, 120 us each with the standard profile
+ */
+void OUTPUT_Flash(uint8_t channelMask, uint8_t periods);
+
+/**
+ * @return a flash is running
+ */
+bool OUTPUT_IsFlashing(void);
+
+/**
+ * Select the dithered channels, takes effect on the next OUTPUT_Commit()
+ * @param channelMask bit n set dithers OutputChannel_t n, all are on by default
+ */
+void OUTPUT_SetDither(uint8_t channelMask);
+
+/**
+ * TMR2 period handler, loads the committed and dithered duties to the
+ * PWM registers
+ */
+void OUTPUT_PeriodISR(void);
+
+#endif // OUTPUT_H
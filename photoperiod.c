@@ -0,0 +1,132 @@
+/*
+ * 24 hour photoperiod program
+ */
+
+#include "mcc_generated_files/mcc.h"
+#include "photoperiod.h"
+#include "journal.h"
+#include "rtc.h"
+
+static uint8_t eventCount;
+static PhotoperiodHandler_t eventHandler;
+
+// the next event, read from EEPROM once the one before it has fired
+static uint8_t next;
+static uint16_t nextMinutes;
+static uint8_t nextAction;
+static bool nextLoaded;
+
+static uint16_t eventAddress(uint8_t index)
+{
+    return PHOTOPERIOD_BASE_ADDRESS + (uint16_t)index * PHOTOPERIOD_EVENT_SIZE;
+}
+
+static uint16_t readMinutes(uint16_t addr)
+{
+    return ((uint16_t)DATAEE_ReadByte(addr) << 8) | DATAEE_ReadByte(addr + 1);
+}
+
+// read an event as the next one, the NVM is clocked for the read only
+static void readEvent(uint8_t index)
+{
+    uint16_t addr = eventAddress(index);
+
+    PMD_NVMEnable();
+    nextMinutes = readMinutes(addr);
+    nextAction = DATAEE_ReadByte(addr + 2);
+    PMD_NVMDisable();
+}
+
+// not while a journal record is being written, the main loop starts no
+// other one meanwhile
+static bool loadNext(void)
+{
+    if(JOURNAL_IsWriting()) {
+        return false;
+    }
+    readEvent(next);
+    return true;
+}
+
+static void fire(uint8_t action, bool ramp)
+{
+    if(eventHandler) {
+        eventHandler(action & 0x0F, ramp ? (uint8_t)((action >> 4) * PHOTOPERIOD_RAMP_UNIT_MINUTES) : 0);
+    }
+}
+
+bool PHOTOPERIOD_Initialize(void)
+{
+    uint16_t previous = 0;
+
+    eventCount = 0;
+    next = 0;
+    nextLoaded = false;
+    PMD_NVMEnable();
+    while(eventCount < PHOTOPERIOD_MAX_EVENTS) {
+        uint16_t minutes = readMinutes(eventAddress(eventCount));
+
+        // end of the day or out of order ends the list
+        if(minutes >= RTC_MINUTES_PER_DAY || (eventCount && minutes <= previous)) {
+            break;
+        }
+        previous = minutes;
+        eventCount++;
+    }
+    PMD_NVMDisable();
+    return eventCount != 0;
+}
+
+void PHOTOPERIOD_SetEventHandler(PhotoperiodHandler_t handler)
+{
+    eventHandler = handler;
+}
+
+void PHOTOPERIOD_Resume(uint16_t minutes)
+{
+    uint8_t current;
+
+    if(eventCount == 0) {
+        return;
+    }
+
+    // before the first event of the day the last one is in effect
+    readEvent(eventCount - 1);
+    current = nextAction;
+
+    // the first event after minutes, the one before it is in effect
+    for(next = 0; next < eventCount; next++) {
+        readEvent(next);
+        if(nextMinutes > minutes) {
+            break;
+        }
+        current = nextAction;
+    }
+    if(next >= eventCount) {
+        next = 0;
+        readEvent(next);
+    }
+    nextLoaded = true;
+    fire(current, false);
+}
+
+void PHOTOPERIOD_MinuteHandler(uint16_t minutes)
+{
+    if(eventCount == 0) {
+        return;
+    }
+    // the journal held the NVM when the last event fired, the next one is
+    // always at least a minute later
+    if(!nextLoaded && !(nextLoaded = loadNext())) {
+        return;
+    }
+    if(minutes != nextMinutes) {
+        return;
+    }
+
+    fire(nextAction, true);
+    if(++next >= eventCount) {
+        next = 0;
+    }
+    nextLoaded = loadNext();
+}
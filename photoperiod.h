@@ -0,0 +1,71 @@
+/*
+ * 24 hour photoperiod program
+ *
+ * A daily list of lighting events in EEPROM, 3 bytes per event from
+ * PHOTOPERIOD_BASE_ADDRESS, sorted by time:
+ *
+ *     minutes after midnight, high byte
+ *     minutes after midnight, low byte
+ *     action: bits 3..0 preset level, PHOTOPERIOD_LEVEL_OFF or
+ *             PHOTOPERIOD_LEVEL_MOONLIGHT; bits 7..4 ramp duration in
+ *             PHOTOPERIOD_RAMP_UNIT_MINUTES, 0 for a plain crossfade
+ *
+ * The list ends at PHOTOPERIOD_MAX_EVENTS or at the first time past the
+ * end of the day (blank EEPROM), an empty list disables the program.
+ * An enabled program replaces the journaled state at every power-up,
+ * counted from RTC_BOOT_MINUTES as long as the clock cannot be set.
+ * Only the next event is kept in RAM, it is read from EEPROM once the
+ * one before it has fired; every minute costs one compare against it.
+ */
+
+#ifndef PHOTOPERIOD_H
+#define PHOTOPERIOD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define PHOTOPERIOD_BASE_ADDRESS        0xF020
+#define PHOTOPERIOD_EVENT_SIZE          3
+#define PHOTOPERIOD_MAX_EVENTS          8
+
+#define PHOTOPERIOD_LEVEL_OFF           0x00
+#define PHOTOPERIOD_LEVEL_MOONLIGHT     0x0F
+#define PHOTOPERIOD_RAMP_UNIT_MINUTES   6
+
+// action byte of an event
+#define PHOTOPERIOD_ACTION(level, rampMinutes) \
+    ((uint8_t)((((rampMinutes) / PHOTOPERIOD_RAMP_UNIT_MINUTES) << 4) | ((level) & 0x0F)))
+
+/**
+ * Called for every event
+ * @param level preset level, PHOTOPERIOD_LEVEL_OFF or PHOTOPERIOD_LEVEL_MOONLIGHT
+ * @param rampMinutes ramp duration, 0 for a plain crossfade
+ */
+typedef void (*PhotoperiodHandler_t)(uint8_t level, uint8_t rampMinutes);
+
+/**
+ * Count the events of the program in EEPROM
+ * @return false if the program is empty
+ */
+bool PHOTOPERIOD_Initialize(void);
+
+/**
+ * Set the function called for every event
+ */
+void PHOTOPERIOD_SetEventHandler(PhotoperiodHandler_t handler);
+
+/**
+ * Apply the event in effect at a time of day as a plain crossfade and
+ * wait for the one after it, at power-up or after the clock was set;
+ * reads the whole list, not while the journal is writing
+ * @param minutes minutes after midnight
+ */
+void PHOTOPERIOD_Resume(uint16_t minutes);
+
+/**
+ * RTC minute handler, fires the next event when its time is reached
+ * @param minutes minutes after midnight
+ */
+void PHOTOPERIOD_MinuteHandler(uint16_t minutes);
+
+#endif // PHOTOPERIOD_H
@@ -0,0 +1,111 @@
+/*
+ * RGBW preset levels of the supported panels
+ *
+ * Measured LED voltages of the calibrated duty values, the table below
+ * holds the logical brightness whose gamma level is closest to each
+ * duty (host/gen_gamma.c, within 1.3 % of the calibrated duty; picked on
+ * the full curve, GAMMA_Level() is at most 0.4 % above it):
+ *
+ *  --+--------------------------------+--------------+
+ *    |      SMALL     |      BIG      |  MANUAL BIG  |
+ *  --+----------------+---------------+--------------+
+ *   1|                |               |              |
+ *   R|   255 - 3.67V  |  255 - 3.24V  |              |
+ *   G|   255 - 2.40V  |  255 - 1.92V  |              |
+ *   B|   255 - 1.97V  |  255 - 1.46V  |              |
+ *   W|   255 - 1.10V  |  255 - 1.08V  |              |
+ *  --+----------------+---------------+--------------+
+ *   2|                |               |              |
+ *   R|    18 - 0.27V  |   18 - 0.25V  |   20 - 0.27V |
+ *   G|    21 - 0.18V  |   21 - 0.15V  |   25 - 0.18V |
+ *   B|    14 - 0.1V   |   14 - 0.08V  |   17 - 0.1V  |
+ *   W|    19 - 0.07V  |   19 - 0.06V  |   22 - 0.07V |
+ *  --+----------------+---------------+--------------+
+ *   3|                |               |              |
+ *   R|    38 - 0.55V  |   38 - 0.49V  |   43 - 0.56V |
+ *   G|    43 - 0.37V  |   43 - 0.30V  |   51 - 0.37V |
+ *   B|    26 - 0.19V  |   26 - 0.15V  |   31 - 0.18V |
+ *   W|    38 - 0.14V  |   38 - 0.11V  |   43 - 0.13V |
+ *  --+----------------+---------------+--------------+
+ *   4|                |               |              |
+ *   R|    85 - 1.2V   |   85 - 1.02V  |   98 - 1.21V |
+ *   G|    86 - 0.74V  |   86 - 0.54V  |  107 - 0.74V |
+ *   B|    54 - 0.39V  |   54 - 0.29V  |   69 - 0.39V |
+ *   W|    75 - 0.29V  |   75 - 0.19V  |  105 - 0.29V |
+ *  --+----------------+---------------+--------------+
+ *   5|                |               |              |
+ *   R|   131 - 1.86V  |  131 - 1.58V  |  150 - 1.84V |
+ *   G|   131 - 1.15V  |  131 - 0.86V  |  162 - 1.15V |
+ *   B|   83  - 0.6V   |   83 - 0.43V  |  110 - 0.6V  |
+ *   W|   113 - 0.44V  |  113 - 0.29V  |  151 - 0.44V |
+ *  --+----------------+---------------+--------------+
+ *   6|                |               |              |
+ *   R|   182 - 2.61V  |  182 - 2.27V  |  206 - 2.6V  |
+ *   G|   174 - 1.6V   |  174 - 1.22V  |  216 - 1.59V |
+ *   B|   110 - 0.82V  |  110 - 0.59V  |  146 - 0.8V  |
+ *   W|   150 - 0.62V  |  150 - 0.42V  |  196 - 0.6V  |
+ *  --+----------------+---------------+--------------+
+ *   7|                |               |              |
+ *   R|   225 - 3.28V  |  225 - 2.92V  |  255 - 3.24V |
+ *   G|   214 - 2.06V  |  214 - 1.6V   |  255 - 1.92V |
+ *   B|   138 - 1.05V  |  138 - 0.74V  |  183 - 1.03V |
+ *   W|   188 - 0.8V   |  210 - 0.58V  |  245 - 0.78V |
+ *  --+----------------+---------------+--------------+
+ */
+
+#include "preset.h"
+#include "fade.h"
+#include "gamma.h"
+
+const uint8_t presetTable[PRESET_PANEL_COUNT][PRESET_LEVEL_COUNT][OUTPUT_CHANNEL_COUNT] = {
+    // SMALL
+    {
+        //  R    G    B    W
+        {  18,  18,  18,  18 },
+        {  81,  88,  71,  84 },
+        { 116, 122,  97, 116 },
+        { 164, 165, 135, 156 },
+        { 196, 196, 162, 184 },
+        { 223, 219, 182, 207 },
+        { 243, 238, 200, 226 }
+    },
+    // BIG (MANUAL BIG column)
+    {
+        //  R    G    B    W
+        {  18,  18,  18,  18 },
+        {  86,  95,  79,  90 },
+        { 122, 132, 106, 122 },
+        { 174, 180, 150, 179 },
+        { 207, 213, 182, 207 },
+        { 234, 239, 205, 230 },
+        { 255, 255, 224, 251 }
+    }
+};
+
+// dim blue with a little white
+const uint8_t presetMoonlight[OUTPUT_CHANNEL_COUNT] = {
+    //  R    G    B    W
+        0,   0,  60,  25
+};
+
+const uint8_t *PRESET_GetBrightness(PanelType_t panel, uint8_t level)
+{
+    if(panel >= PRESET_PANEL_COUNT || level == 0 || level > PRESET_LEVEL_COUNT) {
+        return NULL;
+    }
+    return presetTable[panel][level - 1];
+}
+
+void PRESET_Render(PanelType_t panel, uint8_t level, uint16_t fadeTicks)
+{
+    const uint8_t *brightness = PRESET_GetBrightness(panel, level);
+
+    if(brightness == NULL) {
+        return;
+    }
+    FADE_To(GAMMA_LEVEL(brightness[OUTPUT_RED]),
+            GAMMA_LEVEL(brightness[OUTPUT_GREEN]),
+            GAMMA_LEVEL(brightness[OUTPUT_BLUE]),
+            GAMMA_LEVEL(brightness[OUTPUT_WHITE]),
+            fadeTicks);
+}
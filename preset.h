@@ -0,0 +1,45 @@
+/*
+ * RGBW preset levels of the supported panels
+ */
+
+#ifndef PRESET_H
+#define PRESET_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "output.h"
+
+typedef enum PanelType {
+    SMALL   = 0,
+    BIG     = 1
+} PanelType_t;
+
+#define PRESET_PANEL_COUNT      2
+#define PRESET_LEVEL_COUNT      7
+
+/**
+ * Logical brightness (0..255, see gamma.h) of every level, in flash: [panel][level - 1][channel]
+ */
+extern const uint8_t presetTable[PRESET_PANEL_COUNT][PRESET_LEVEL_COUNT][OUTPUT_CHANNEL_COUNT];
+
+/**
+ * Logical brightness of the moonlight, the same on every panel
+ */
+extern const uint8_t presetMoonlight[OUTPUT_CHANNEL_COUNT];
+
+/**
+ * @param panel panel type
+ * @param level 1..PRESET_LEVEL_COUNT
+ * @return the OUTPUT_CHANNEL_COUNT logical brightness values of the level, NULL if out of range
+ */
+const uint8_t *PRESET_GetBrightness(PanelType_t panel, uint8_t level);
+
+/**
+ * Fade the output to the brightness of a preset level
+ * @param panel panel type
+ * @param level 1..PRESET_LEVEL_COUNT, other values are ignored
+ * @param fadeTicks crossfade duration in scheduler ticks, 0 for a hard switch
+ */
+void PRESET_Render(PanelType_t panel, uint8_t level, uint16_t fadeTicks);
+
+#endif // PRESET_H
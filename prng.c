@@ -0,0 +1,58 @@
+/*
+ * Pseudo random numbers for the effects
+ */
+
+#include "prng.h"
+
+#define PRNG_SEED       0xACE1
+
+// draws of PRNG_Below() before it folds the last one into range
+#define PRNG_MAX_DRAWS  4
+
+// 32 bits of state in two words, never both 0, xorshift stays there once there
+static uint16_t x = 1;
+static uint16_t y = PRNG_SEED;
+
+void PRNG_Stir(uint16_t entropy)
+{
+    y ^= entropy;
+    if(x == 0 && y == 0) {
+        y = PRNG_SEED;
+    }
+}
+
+uint16_t PRNG_Next(void)
+{
+    uint16_t t = x ^ (x << 5);
+
+    x = y;
+    y = (y ^ (y >> 1)) ^ (t ^ (t >> 3));
+    return y;
+}
+
+uint8_t PRNG_Below(uint8_t bound)
+{
+    uint8_t mask = bound - 1;
+    uint8_t value;
+    uint8_t draws = PRNG_MAX_DRAWS;
+
+    if(bound < 2) {
+        return 0;
+    }
+
+    // smallest all ones mask covering bound - 1, a draw is kept more than half the time
+    mask |= mask >> 1;
+    mask |= mask >> 2;
+    mask |= mask >> 4;
+    do {
+        // the high byte mixes better than the low one
+        value = (uint8_t)(PRNG_Next() >> 8) & mask;
+        if(value < bound) {
+            return value;
+        }
+    } while(--draws);
+
+    // bounded time for the tick tasks, one call in 2^PRNG_MAX_DRAWS at worst
+    // takes the lower half of the range
+    return value & (mask >> 1);
+}
@@ -0,0 +1,39 @@
+/*
+ * Pseudo random numbers for the effects
+ *
+ * xorshift on two 16 bit words (5, 3, 1): period 2^32 - 1, a few shifts and
+ * xors per number, no multiply and no divide. A single 16 bit word repeats
+ * too soon, draws of alternating bounds lock onto its cycle and go 10 %
+ * off uniform. Bounded numbers come from masking and rejecting, on average
+ * fewer than two draws and never more than four, which leaves them a little
+ * off uniform, see PRNG_Below(). Not for anything but looks.
+ */
+
+#ifndef PRNG_H
+#define PRNG_H
+
+#include <stdint.h>
+
+/**
+ * Mix something unpredictable into the state, e.g. the tick of a button press
+ * @param entropy any value
+ */
+void PRNG_Stir(uint16_t entropy);
+
+/**
+ * @return next number
+ */
+uint16_t PRNG_Next(void);
+
+/**
+ * Number below a bound, without a division. Close to uniform: when four
+ * draws in a row miss the bound the last one is folded into the lower
+ * half of the mask, so a value there is up to 0.52 % more likely than
+ * 1 / bound and one above up to 5.5 % less (bounds 77 and 33); for the
+ * 40 brightnesses of the random effect +0.49 % and -2.0 %
+ * @param bound 1..255
+ * @return 0..bound - 1, 0 for a bound of 0 or 1
+ */
+uint8_t PRNG_Below(uint8_t bound);
+
+#endif // PRNG_H
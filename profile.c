@@ -0,0 +1,81 @@
+/*
+ * PWM frequency / resolution profiles
+ */
+
+#include "profile.h"
+#include "rtc.h"
+
+typedef struct ProfileEntry {
+    OutputTiming_t fast;
+    uint8_t slowPeriod;         // PR2 at HFINTOSC / 2, 0 if the period gets too short
+    uint16_t tickMicroseconds;
+} ProfileEntry_t;
+
+// OSCCON1 NDIV codes
+#define NDIV_1      0x00
+#define NDIV_2      0x01
+
+static const ProfileEntry_t profiles[PROFILE_COUNT] = {
+    //  PR2   T2CON NDIV    factor  slow PR2  tick
+    { { 0xBF, 0x24, NDIV_1, 25 },   0x5F,     3000 },  // STANDARD
+    { { 0x4F, 0x5C, NDIV_1, 25 },   0x00,     3000 },  // HIGH_FREQUENCY
+    { { 0xFF, 0x14, NDIV_1, 31 },   0x7F,     2976 },  // MAX_RESOLUTION
+    { { 0xBF, 0x05, NDIV_1, 31 },   0x5F,     2976 }   // LOW_FREQUENCY
+};
+
+static PwmProfile_t selected;
+static bool slowClock;
+
+static void apply(void)
+{
+    const ProfileEntry_t *entry = &profiles[selected];
+    OutputTiming_t timing = entry->fast;
+
+    if(slowClock) {
+        timing.period = entry->slowPeriod;
+        timing.clockDivider = NDIV_2;
+    }
+    OUTPUT_SetTiming(&timing);
+    RTC_SetTickMicroseconds(entry->tickMicroseconds);
+}
+
+void PROFILE_Initialize(void)
+{
+    selected = PROFILE_DEFAULT;
+    slowClock = false;
+    apply();
+}
+
+void PROFILE_Select(PwmProfile_t profile)
+{
+    if(profile >= PROFILE_COUNT) {
+        return;
+    }
+    selected = profile;
+    if(profiles[selected].slowPeriod == 0) {
+        slowClock = false;
+    }
+    apply();
+}
+
+PwmProfile_t PROFILE_Get(void)
+{
+    return selected;
+}
+
+bool PROFILE_SetSlow(bool slow)
+{
+    if(slow && profiles[selected].slowPeriod == 0) {
+        return false;
+    }
+    if(slow != slowClock) {
+        slowClock = slow;
+        apply();
+    }
+    return true;
+}
+
+bool PROFILE_IsSlow(void)
+{
+    return slowClock;
+}
@@ -0,0 +1,67 @@
+/*
+ * PWM frequency / resolution profiles
+ *
+ * Every profile keeps the period interrupt near 120 us and the scheduler
+ * tick near 3 ms by pairing PR2 and the prescaler with a postscaler and a
+ * ticker factor (instruction cycles at 32 MHz):
+ *
+ *                    PR2   pre  post  factor  PWM        codes  tick
+ *   STANDARD         0xBF  1:1  1:5   25      41.7 kHz    768   3.000 ms
+ *   HIGH_FREQUENCY   0x4F  1:1  1:12  25      100 kHz     320   3.000 ms
+ *   MAX_RESOLUTION   0xFF  1:1  1:3   31      31.3 kHz   1024   2.976 ms
+ *   LOW_FREQUENCY    0xBF  1:4  1:1   31      10.4 kHz    768   2.976 ms
+ *
+ * The RTC is told the exact tick length; other tick based durations are
+ * off by at most 0.8 %. Levels are period independent, the output stage
+ * rescales the duties so the brightness stays the same across a switch.
+ */
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "output.h"
+
+typedef enum PwmProfile {
+    PROFILE_STANDARD        = 0,
+    PROFILE_HIGH_FREQUENCY  = 1,    // camera safe, flicker free
+    PROFILE_MAX_RESOLUTION  = 2,
+    PROFILE_LOW_FREQUENCY   = 3,    // lowest switching loss and EMI
+    PROFILE_COUNT
+} PwmProfile_t;
+
+// profile at power-up
+#ifndef PROFILE_DEFAULT
+#define PROFILE_DEFAULT         PROFILE_STANDARD
+#endif
+
+/**
+ * Select PROFILE_DEFAULT
+ */
+void PROFILE_Initialize(void);
+
+/**
+ * Switch to a profile, takes effect on the next OUTPUT_Commit()
+ * @param profile out of range values are ignored
+ */
+void PROFILE_Select(PwmProfile_t profile);
+
+/**
+ * @return selected profile
+ */
+PwmProfile_t PROFILE_Get(void);
+
+/**
+ * Select the full or the halved system clock of the profile, see clock.h
+ * @param slow run from HFINTOSC / 2 with half the period
+ * @return false if the profile has no slow variant, the clock stays fast
+ */
+bool PROFILE_SetSlow(bool slow);
+
+/**
+ * @return running the slow variant of the profile
+ */
+bool PROFILE_IsSlow(void);
+
+#endif // PROFILE_H
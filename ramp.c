@@ -0,0 +1,26 @@
+/*
+ * Sunrise / sunset ramp
+ */
+
+#include "fade.h"
+#include "ramp.h"
+
+void RAMP_To(uint16_t red, uint16_t green, uint16_t blue, uint16_t white, uint32_t steps)
+{
+    FADE_Start(FADE_MODE_RAMP, red, green, blue, white, steps);
+}
+
+void RAMP_Stop(void)
+{
+    FADE_StopMode(FADE_MODE_RAMP);
+}
+
+bool RAMP_IsActive(void)
+{
+    return FADE_IsRunning(FADE_MODE_RAMP);
+}
+
+void RAMP_Task(void)
+{
+    FADE_Step(FADE_MODE_RAMP);
+}
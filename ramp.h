@@ -0,0 +1,51 @@
+/*
+ * Sunrise / sunset ramp
+ *
+ * Long ramps, minutes to hours, from the current output levels to a
+ * target. A ramp is a trajectory of the crossfade engine (see fade.h)
+ * stepped every RAMP_STEP_TICKS; the Q16.16 accumulators make one step a
+ * small fraction of a duty count, so no staircase is visible even at the
+ * slowest rates. A ramp and a fade replace each other.
+ */
+
+#ifndef RAMP_H
+#define RAMP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "scheduler.h"
+
+// scheduler period of RAMP_Task()
+#define RAMP_STEP_TICKS         8
+
+// default sunrise / sunset duration
+#ifndef RAMP_DEFAULT_MINUTES
+#define RAMP_DEFAULT_MINUTES    30
+#endif
+
+// ramp steps of a duration in minutes
+#define RAMP_MINUTES_TO_STEPS(minutes) \
+    ((uint32_t)(minutes) * 60000UL / (SCHEDULER_TICK_MS * RAMP_STEP_TICKS))
+
+/**
+ * Start a ramp from the current output levels, replaces a running fade or ramp
+ * @param steps duration in RAMP_Task() calls, 0 sets the target at once
+ */
+void RAMP_To(uint16_t red, uint16_t green, uint16_t blue, uint16_t white, uint32_t steps);
+
+/**
+ * Stop the ramp, the outputs keep their current levels; a fade runs on
+ */
+void RAMP_Stop(void);
+
+/**
+ * @return a ramp is running
+ */
+bool RAMP_IsActive(void);
+
+/**
+ * One ramp step, scheduler task with a period of RAMP_STEP_TICKS
+ */
+void RAMP_Task(void);
+
+#endif // RAMP_H
@@ -0,0 +1,68 @@
+/*
+ * Software real-time clock
+ */
+
+#include "rtc.h"
+
+static uint32_t microseconds;
+static uint32_t taskMicroseconds = (uint32_t)SCHEDULER_TICK_MS * 1000 * RTC_TASK_TICKS;
+static uint8_t seconds;
+static uint16_t minutes;
+static uint16_t days;
+static void (*minuteHandler)(uint16_t minutes);
+
+void RTC_Initialize(void)
+{
+    minuteHandler = 0;
+    days = 0;
+    RTC_SetMinutes(RTC_BOOT_MINUTES);
+}
+
+void RTC_Task(void)
+{
+    microseconds += taskMicroseconds;
+    if(microseconds < 1000000UL) {
+        return;
+    }
+    microseconds -= 1000000UL;
+
+    if(++seconds < 60) {
+        return;
+    }
+    seconds = 0;
+
+    if(++minutes >= RTC_MINUTES_PER_DAY) {
+        minutes = 0;
+        days++;
+    }
+    if(minuteHandler) {
+        minuteHandler(minutes);
+    }
+}
+
+uint16_t RTC_GetMinutes(void)
+{
+    return minutes;
+}
+
+uint16_t RTC_GetDays(void)
+{
+    return days;
+}
+
+void RTC_SetMinutes(uint16_t value)
+{
+    microseconds = 0;
+    seconds = 0;
+    minutes = value % RTC_MINUTES_PER_DAY;
+}
+
+void RTC_SetTickMicroseconds(uint16_t tickMicroseconds)
+{
+    taskMicroseconds = (uint32_t)tickMicroseconds * RTC_TASK_TICKS;
+}
+
+void RTC_SetMinuteHandler(void (* MinuteHandler)(uint16_t minutes))
+{
+    minuteHandler = MinuteHandler;
+}
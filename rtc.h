@@ -0,0 +1,66 @@
+/*
+ * Software real-time clock
+ *
+ * Time of day kept from the scheduler tick. The tick is a whole number of
+ * instruction cycles, 3 ms in the standard profile, and its exact length
+ * is set by the PWM profile, so the clock is as good as the HFINTOSC
+ * calibration (about +-1 %, trimmable through OSCTUNE).
+ * There is no way to set the time from the button: the clock starts at
+ * RTC_BOOT_MINUTES at power-up, so the fixture is meant to be powered on
+ * at that time of day (or by a mains timer); RTC_SetMinutes() sets it.
+ */
+
+#ifndef RTC_H
+#define RTC_H
+
+#include <stdint.h>
+#include "scheduler.h"
+
+#define RTC_MINUTES_PER_DAY     1440
+
+// time of day at power-up, minutes after midnight
+#ifndef RTC_BOOT_MINUTES
+#define RTC_BOOT_MINUTES        (8 * 60)
+#endif
+
+// scheduler period of RTC_Task()
+#define RTC_TASK_TICKS          100
+
+/**
+ * Start the clock at RTC_BOOT_MINUTES
+ */
+void RTC_Initialize(void);
+
+/**
+ * Advance the clock, scheduler task with a period of RTC_TASK_TICKS
+ */
+void RTC_Task(void);
+
+/**
+ * @return minutes after midnight, 0..RTC_MINUTES_PER_DAY - 1
+ */
+uint16_t RTC_GetMinutes(void);
+
+/**
+ * @return midnights passed since power-up, wraps after 179 years
+ */
+uint16_t RTC_GetDays(void);
+
+/**
+ * Set the time of day, the seconds restart from 0
+ * @param minutes minutes after midnight, wrapped to a day
+ */
+void RTC_SetMinutes(uint16_t minutes);
+
+/**
+ * Set the scheduler tick length, SCHEDULER_TICK_MS until set
+ * @param microseconds tick length
+ */
+void RTC_SetTickMicroseconds(uint16_t microseconds);
+
+/**
+ * Set the function called from RTC_Task() on every new minute
+ */
+void RTC_SetMinuteHandler(void (* MinuteHandler)(uint16_t minutes));
+
+#endif // RTC_H
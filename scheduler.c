@@ -0,0 +1,76 @@
+/*
+ * Cooperative tick scheduler
+ */
+
+#include "scheduler.h"
+
+typedef struct SchedulerEntry {
+    SchedulerTask_t task;
+    uint8_t period;
+    uint8_t countdown;
+} SchedulerEntry_t;
+
+static SchedulerEntry_t tasks[SCHEDULER_MAX_TASKS];
+static uint8_t taskCount = 0;
+
+// ticks counted by the ISR and not yet dispatched
+static volatile uint8_t pendingTicks = 0;
+static uint16_t ticks = 0;
+
+void SCHEDULER_Initialize(void)
+{
+    taskCount = 0;
+    pendingTicks = 0;
+    ticks = 0;
+}
+
+bool SCHEDULER_AddTask(SchedulerTask_t task, uint8_t period)
+{
+    if(taskCount >= SCHEDULER_MAX_TASKS) {
+        return false;
+    }
+
+    if(period == 0) {
+        period = 1;
+    }
+
+    tasks[taskCount].task = task;
+    tasks[taskCount].period = period;
+    tasks[taskCount].countdown = period;
+    ++taskCount;
+    return true;
+}
+
+void SCHEDULER_Tick(void)
+{
+    // saturate instead of wrapping if the main loop falls far behind
+    if(pendingTicks != 0xFF) {
+        ++pendingTicks;
+    }
+}
+
+void SCHEDULER_Run(void)
+{
+    while(pendingTicks) {
+        // single byte decrement, atomic against the ISR increment
+        --pendingTicks;
+        ++ticks;
+
+        for(uint8_t i = 0; i < taskCount; i++) {
+            if(--tasks[i].countdown == 0) {
+                tasks[i].countdown = tasks[i].period;
+                tasks[i].task();
+            }
+        }
+    }
+}
+
+uint16_t SCHEDULER_GetTicks(void)
+{
+    return ticks;
+}
+
+bool SCHEDULER_IsPending(void)
+{
+    return pendingTicks != 0;
+}
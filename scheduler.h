@@ -0,0 +1,61 @@
+/*
+ * Cooperative tick scheduler
+ *
+ * The TMR2 callback (every TMR2_INTERRUPT_TICKER_FACTOR postscaled periods)
+ * only counts ticks. Tasks run from the main loop, so they must be short,
+ * non-blocking steps that keep their own state between calls.
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// tick period: 192 TMR2 counts * 5 (postscaler) * 25 (ticker factor) at 8 MHz
+#define SCHEDULER_TICK_MS       3
+
+// maximum number of registered tasks
+#define SCHEDULER_MAX_TASKS     7
+
+// convert milliseconds to ticks, rounded to the nearest tick (at least 1)
+#define SCHEDULER_MS_TO_TICKS(ms) \
+    ((uint16_t)((ms) < SCHEDULER_TICK_MS ? 1 : ((ms) + SCHEDULER_TICK_MS / 2) / SCHEDULER_TICK_MS))
+
+typedef void (*SchedulerTask_t)(void);
+
+/**
+ * Remove every task and drop pending ticks
+ */
+void SCHEDULER_Initialize(void);
+
+/**
+ * Register a periodic task
+ * @param task function called from SCHEDULER_Run()
+ * @param period call period in ticks, up to 255 (0 is treated as 1)
+ * @return false if the task table is full
+ */
+bool SCHEDULER_AddTask(SchedulerTask_t task, uint8_t period);
+
+/**
+ * Count one tick. Called from the TMR2 callback (interrupt context).
+ */
+void SCHEDULER_Tick(void);
+
+/**
+ * Run the due tasks for every tick elapsed since the last call.
+ * Called from the main loop, never blocks.
+ */
+void SCHEDULER_Run(void);
+
+/**
+ * @return free running tick counter (main loop context)
+ */
+uint16_t SCHEDULER_GetTicks(void);
+
+/**
+ * @return ticks are waiting for SCHEDULER_Run()
+ */
+bool SCHEDULER_IsPending(void);
+
+#endif // SCHEDULER_H
@@ -0,0 +1,139 @@
+/*
+ * Weather over the scene
+ */
+
+#include "output.h"
+#include "prng.h"
+#include "weather.h"
+
+#define SECOND_TICKS    SCHEDULER_MS_TO_TICKS(1000)
+
+// seconds and depths as at least and random extra, a spell at most 196 s
+typedef struct WeatherClimate {
+    uint8_t gapSeconds;     // clear sky between two clouds
+    uint8_t gapRange;
+    uint8_t holdSeconds;    // a cloud stays over
+    uint8_t holdRange;
+    uint8_t depth;          // dip of a cloud in 1/256 of the scene
+    uint8_t depthRange;
+} WeatherClimate_t;
+
+static const WeatherClimate_t climates[WEATHER_MODE_COUNT] = {
+    //  gap       hold      depth
+    {   0,   0,   0,   0,   0,   0 },  // WEATHER_CLEAR
+    {  30, 120,   5,  25,  30,  70 },  // WEATHER_CLOUDY: 12..39 % for 5..30 s
+    {   5,  20,  20,  60, 100,  90 },  // WEATHER_STORM: 39..74 % for 20..80 s
+};
+
+static WeatherMode_t current;
+static bool covered;            // a cloud is over or coming
+static uint16_t countdown;      // ticks left of the clear spell or the cloud
+
+// cloud cover in Q15 of the scene: target, first and second low pass stage
+static uint16_t target;
+static uint16_t cover;
+static uint16_t shade;
+
+// lightning under a storm cloud
+static uint16_t strikeCountdown;
+static uint8_t flashesLeft;
+
+void WEATHER_Initialize(void)
+{
+    current = WEATHER_CLEAR;
+    covered = false;
+    countdown = 0;
+    target = 0;
+    cover = 0;
+    shade = 0;
+    flashesLeft = 0;
+}
+
+static uint16_t randomSeconds(uint8_t seconds, uint8_t range)
+{
+    return (uint16_t)(seconds + PRNG_Below(range + 1)) * SECOND_TICKS;
+}
+
+// one low pass step, the last ones crawl so it lands on the target
+static uint16_t follow(uint16_t value, uint16_t goal)
+{
+    int16_t step = (int16_t)(goal - value) >> WEATHER_SMOOTH_SHIFT;
+
+    if(step == 0 && goal != value) {
+        step = goal > value ? 1 : -1;
+    }
+    return value + step;
+}
+
+static void clouds(WeatherMode_t mode)
+{
+    const WeatherClimate_t *climate = &climates[mode];
+
+    if(mode != current) {
+        // a new climate starts with clear sky, a cloud over it moves on
+        current = mode;
+        covered = false;
+        target = 0;
+        countdown = randomSeconds(climate->gapSeconds, climate->gapRange);
+    }
+
+    if(mode == WEATHER_CLEAR) {
+        // stays clear
+    } else if(countdown) {
+        countdown--;
+    } else if(covered) {
+        covered = false;
+        target = 0;
+        countdown = randomSeconds(climate->gapSeconds, climate->gapRange);
+    } else {
+        covered = true;
+        target = (uint16_t)(climate->depth + PRNG_Below(climate->depthRange + 1)) << 7;
+        countdown = randomSeconds(climate->holdSeconds, climate->holdRange);
+    }
+
+    cover = follow(cover, target);
+    shade = follow(shade, cover);
+}
+
+static void lightning(WeatherMode_t mode)
+{
+    if(mode != WEATHER_STORM || !covered) {
+        flashesLeft = 0;
+        strikeCountdown = WEATHER_FIRST_STRIKE_TICKS;
+        return;
+    }
+
+    if(strikeCountdown) {
+        strikeCountdown--;
+        return;
+    }
+
+    if(flashesLeft == 0) {
+        flashesLeft = 1 + PRNG_Below(WEATHER_BURST_FLASHES);
+    }
+    OUTPUT_Flash(1 << OUTPUT_WHITE, WEATHER_FLASH_PERIODS + PRNG_Below(WEATHER_FLASH_RANGE + 1));
+
+    if(--flashesLeft) {
+        strikeCountdown = WEATHER_FLASH_GAP_TICKS + PRNG_Below(WEATHER_FLASH_GAP_RANGE + 1);
+    } else {
+        strikeCountdown = randomSeconds(WEATHER_BURST_GAP_SECONDS, WEATHER_BURST_GAP_RANGE);
+    }
+}
+
+void WEATHER_Task(WeatherMode_t mode)
+{
+    if(mode >= WEATHER_MODE_COUNT) {
+        mode = WEATHER_CLEAR;
+    }
+
+    clouds(mode);
+    lightning(mode);
+
+    // Q15 shade to 1/256 of the scene, unchanged gains cost a compare
+    OUTPUT_SetGain(OUTPUT_GAIN_UNITY - (shade >> 7));
+}
+
+bool WEATHER_IsActive(void)
+{
+    return cover != target || shade != cover || flashesLeft || OUTPUT_IsFlashing();
+}
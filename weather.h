@@ -0,0 +1,67 @@
+/*
+ * Weather over the scene
+ *
+ * Clouds pass now and then and dim every channel through the output gain,
+ * storms add bursts of white lightning under their clouds. Times, depths
+ * and flashes are drawn from the PRNG. The cloud cover follows its random
+ * target through two one pole low passes, a soft S-shaped dip with no
+ * multiply; a tick costs two filter steps, at most two random draws and
+ * the output rescale while the gain moves. The flashes are timed by the
+ * period interrupt (see OUTPUT_Flash()), not by the tick.
+ *
+ * The levels the fades and ramps work from are left alone, a clearing sky
+ * returns the scene exactly as it was.
+ */
+
+#ifndef WEATHER_H
+#define WEATHER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "scheduler.h"
+
+typedef enum WeatherMode {
+    WEATHER_CLEAR  = 0,     // no overlay, a passing cloud moves on
+    WEATHER_CLOUDY = 1,     // light clouds every minute or two
+    WEATHER_STORM  = 2,     // dark clouds in quick succession, lightning under them
+    WEATHER_MODE_COUNT
+} WeatherMode_t;
+
+// cloud cover low pass time constant, 2^n ticks per stage (~0.8 s)
+#define WEATHER_SMOOTH_SHIFT        8
+
+// the first lightning after a storm cloud came over
+#define WEATHER_FIRST_STRIKE_TICKS  SCHEDULER_MS_TO_TICKS(4000)
+
+// seconds between bursts under a storm cloud, at least and random extra
+#define WEATHER_BURST_GAP_SECONDS   3
+#define WEATHER_BURST_GAP_RANGE     12
+
+// flashes per burst, 1..WEATHER_BURST_FLASHES
+#define WEATHER_BURST_FLASHES       4
+
+// time between the flashes of a burst, at least and random extra
+#define WEATHER_FLASH_GAP_TICKS     SCHEDULER_MS_TO_TICKS(30)
+#define WEATHER_FLASH_GAP_RANGE     SCHEDULER_MS_TO_TICKS(220)
+
+// flash length in period interrupts (120 us), at least and random extra
+#define WEATHER_FLASH_PERIODS       8
+#define WEATHER_FLASH_RANGE         56
+
+/**
+ * Clear sky
+ */
+void WEATHER_Initialize(void);
+
+/**
+ * Advance the weather by one tick and set the output gain
+ * @param mode weather to move towards, a change starts with a clear spell
+ */
+void WEATHER_Task(WeatherMode_t mode);
+
+/**
+ * @return the cover or a flash is changing the output
+ */
+bool WEATHER_IsActive(void);
+
+#endif // WEATHER_H